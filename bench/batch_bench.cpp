@@ -0,0 +1,130 @@
+// Batched detector throughput: runs HandTracker::inferBatch on groups of 1, 2,
+// 4 and 8 frames (standing in for that many cameras) from a recorded clip and
+// reports frames per second and per-batch latency.
+//
+//   ./MillBatchBench --device_name clips/hands.mp4 --bench_iterations 240
+
+#include "bench_common.hpp"
+
+#include <my_webcam.hpp>
+#include <my_hands.hpp>
+#include <my_cli.hpp>
+#include <my_timing.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static const int BATCH_SIZES[] = {1, 2, 4, 8};
+
+struct BatchResult {
+    int batch = 1;
+    double framesPerSec = 0.0;
+    TimingStats batchMs;
+    TimingStats forwardMs;
+};
+
+static void writeReport(std::ostream& os, const CLIOptions& options, size_t frameCount,
+                        const std::string& backend, const std::vector<BatchResult>& results) {
+    os << "{\n"
+       << "  \"benchmark\": \"batch\",\n"
+       << "  \"source\": \"" << options.deviceName << "\",\n"
+       << "  \"frames\": " << frameCount << ",\n"
+       << "  \"detector_input\": " << options.onnxInputSize << ",\n"
+       << "  \"dnn_backend\": \"" << backend << "\",\n"
+       << "  \"batches\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BatchResult& r = results[i];
+        os << "    {\"batch\": " << r.batch << ", \"frames_per_sec\": " << r.framesPerSec << ", \"batch_ms\": ";
+        r.batchMs.writeJson(os);
+        os << ", \"forward_ms\": ";
+        r.forwardMs.writeJson(os);
+        os << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    CLIOptions options = parseCli(argc, argv);
+    if (options.show_help) {
+        printHelp(argv[0]);
+        return 0;
+    }
+
+    std::unique_ptr<MyWebcam> source;
+    try {
+        source = std::make_unique<MyWebcam>(options.webcamName, options.deviceName,
+            options.screenWidth, options.screenHeight, options.fps);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    std::string errMsg;
+    std::vector<cv::Mat> frames;
+    cv::Mat frame;
+    while (frames.size() < options.benchIterations && source->readFrame(frame, errMsg) == 0) {
+        frames.push_back(frame.clone());
+    }
+    if (frames.empty()) {
+        std::cerr << "No frames read from " << options.deviceName << ": " << errMsg << std::endl;
+        return -1;
+    }
+
+    HandTracker tracker;
+    InferenceEngine engine = ENGINE_OPENCV_DNN;
+    parseInferenceEngine(options.inferenceEngine, engine);
+    tracker.setEngine(engine, static_cast<int>(options.ortIntraOpThreads));
+    tracker.setFusion(options.dnnFusion);
+    if (!tracker.load(options.detectorModelPath(), options.onnxInputSize, false, errMsg)) {
+        std::cerr << "HandTracker load failed: " << errMsg << std::endl;
+        return -1;
+    }
+    std::vector<BackendCandidate> backends;
+    if (!parseBackendList(options.dnnBackends, backends, errMsg)
+        || !tracker.selectBackend(backends, options.backendCachePath, errMsg)) {
+        std::cerr << "Warning: backend selection failed: " << errMsg << std::endl;
+    }
+
+    std::vector<BatchResult> results;
+    std::vector<cv::Mat> group;
+    for (int batch : BATCH_SIZES) {
+        BatchResult result;
+        result.batch = batch;
+
+        // Every batch size processes the same frames, in groups of `batch`
+        auto runGroup = [&](size_t first) {
+            group.clear();
+            for (int i = 0; i < batch; ++i) group.push_back(frames[(first + i) % frames.size()]);
+            return tracker.inferBatch(group);
+        };
+        for (unsigned int w = 0; w < std::max(1u, options.benchWarmup / batch); ++w) {
+            runGroup(w * batch);
+        }
+
+        auto start = SteadyClock::now();
+        size_t processed = 0;
+        for (size_t first = 0; first < frames.size(); first += batch) {
+            auto groupStart = SteadyClock::now();
+            runGroup(first);
+            result.batchMs.add(elapsedMs(groupStart, SteadyClock::now()));
+            result.forwardMs.add(tracker.lastTimings().forwardMs);
+            processed += batch;
+        }
+        double sec = elapsedMs(start, SteadyClock::now()) / 1000.0;
+        result.framesPerSec = sec > 0.0 ? processed / sec : 0.0;
+
+        std::cerr << "batch " << batch << ": " << result.framesPerSec << " frames/s" << std::endl;
+        result.batchMs.printSummary("  batch latency", std::cerr);
+        results.push_back(std::move(result));
+    }
+
+    auto report = [&](std::ostream& os) {
+        writeReport(os, options, frames.size(), tracker.backendName(), results);
+    };
+    if (!writeBenchReport(options, report)) {
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "bench_common.hpp"
+
+#include <my_scene.hpp>
+#include <my_texture_cache.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <fstream>
+
+bool writeBenchReport(const CLIOptions& options, const std::function<void(std::ostream&)>& writer) {
+    if (options.benchJsonPath.empty()) {
+        writer(std::cout);
+        return true;
+    }
+    std::ofstream out(options.benchJsonPath);
+    if (!out) {
+        std::cerr << "Could not open " << options.benchJsonPath << std::endl;
+        return false;
+    }
+    writer(out);
+    std::cerr << "Wrote " << options.benchJsonPath << std::endl;
+    return true;
+}
+
+void BenchModeResult::printSummary(unsigned int frames, std::ostream& os) const {
+    submit.printSummary("  submit", os);
+    frame.printSummary("  frame", os);
+    gpu.printSummary("  gpu", os);
+    os << "  " << samplesPassed << " samples passed per frame" << std::endl;
+    glCalls.printPerFrame(frames, os);
+}
+
+void BenchModeResult::writeJsonFields(unsigned int frames, std::ostream& os) const {
+    os << "\"submit_ms\": ";
+    submit.writeJson(os);
+    os << ",\n     \"frame_ms\": ";
+    frame.writeJson(os);
+    os << ",\n     \"gpu_ms\": ";
+    gpu.writeJson(os);
+    os << ",\n     \"samples_passed_per_frame\": " << samplesPassed
+       << ",\n     \"gl_calls_per_frame\": ";
+    glCalls.writeJsonPerFrame(frames, os);
+}
+
+BenchCamera benchCameraAt(const CLIOptions& options, const glm::vec3& position, float fovDegrees, float farPlane) {
+    BenchCamera camera;
+    camera.position = position;
+    camera.view = glm::lookAt(position, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    camera.projection = glm::perspective(glm::radians(fovDegrees),
+        static_cast<float>(options.screenWidth) / static_cast<float>(options.screenHeight), 0.1f, farPlane);
+    return camera;
+}
+
+void useBenchShader(Shader& shader, const BenchCamera& camera) {
+    shader.use();
+    shader.setMat4("view", camera.view);
+    shader.setMat4("projection", camera.projection);
+    shader.setVec3("lightPos", glm::vec3(5.0f, 0.0f, 5.0f));
+    shader.setVec3("viewPos", camera.position);
+    shader.setFloat("shininess", 32.0f);
+}
+
+BenchScene::BenchScene(const CLIOptions& options)
+    : options_(options), ctx_(options.screenWidth, options.screenHeight) {}
+
+BenchScene::~BenchScene() {
+    if (queries_[0] != 0) glDeleteQueries(2, queries_);
+}
+
+bool BenchScene::initialize(std::string& errMsg) {
+    if (!ctx_.initialize(errMsg)) {
+        errMsg = "Failed to setup headless rendering: " + errMsg;
+        return false;
+    }
+    configureGLState();
+
+    TextureCache& textures = TextureCache::instance();
+    textures.setPreferCompressed(options_.compressedTextures);
+    textures.setStreaming(options_.textureStreaming);
+    earth_ = std::make_unique<Model>(options_.earthModelPath, "Earth", options_.keepMeshData);
+    moon_ = std::make_unique<Model>(options_.moonModelPath, "Moon", options_.keepMeshData);
+    spitfire_ = std::make_unique<Model>(options_.spitfireModelPath, "Spitfire", options_.keepMeshData);
+    textures.finishUploads();
+
+    glGenQueries(2, queries_);
+    return true;
+}
+
+void BenchScene::runFrames(BenchModeResult& result, const std::function<void(float time, bool measured)>& draw) {
+    uint64_t samplesPassed = 0;
+    const unsigned int frames = options_.benchWarmup + options_.benchIterations;
+    for (unsigned int f = 0; f < frames; ++f) {
+        const float time = static_cast<float>(f) / 60.0f;
+        const bool measured = f >= options_.benchWarmup;
+        if (f == options_.benchWarmup) frameRenderCounters() = RenderCounters();
+
+        auto frameStart = SteadyClock::now();
+        ctx_.bindFramebuffer();
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glBeginQuery(GL_TIME_ELAPSED, queries_[0]);
+        glBeginQuery(GL_SAMPLES_PASSED, queries_[1]);
+        countingSamples_ = true;
+        draw(time, measured);
+        endSamplesPassed();
+        glEndQuery(GL_TIME_ELAPSED);
+        auto submitEnd = SteadyClock::now();
+        ctx_.finish();
+        auto frameEnd = SteadyClock::now();
+
+        if (measured) {
+            GLuint64 gpuNs = 0, passed = 0;
+            glGetQueryObjectui64v(queries_[0], GL_QUERY_RESULT, &gpuNs);
+            glGetQueryObjectui64v(queries_[1], GL_QUERY_RESULT, &passed);
+            result.submit.add(elapsedMs(frameStart, submitEnd));
+            result.frame.add(elapsedMs(frameStart, frameEnd));
+            result.gpu.add(static_cast<double>(gpuNs) / 1e6);
+            samplesPassed += passed;
+            endRenderFrame(result.glCalls);
+        }
+    }
+    result.samplesPassed = options_.benchIterations
+        ? static_cast<double>(samplesPassed) / options_.benchIterations : 0.0;
+}
+
+void BenchScene::endSamplesPassed() {
+    if (!countingSamples_) return;
+    glEndQuery(GL_SAMPLES_PASSED);
+    countingSamples_ = false;
+}
@@ -0,0 +1,84 @@
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+
+#include <glad/glad.h>
+
+#include <my_cli.hpp>
+#include <my_headless.hpp>
+#include <my_model.hpp>
+#include <my_render_stats.hpp>
+#include <my_shader.hpp>
+#include <my_timing.hpp>
+
+#include <glm/glm.hpp>
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Helpers shared by the benchmarks: the JSON report tail, and for the
+// headless scene benchmarks (MillSceneBench, MillOcclusionBench) the context,
+// the app's three models, a fixed camera and a frame loop timed with GPU queries.
+
+// Call writer() on stdout, or on bench_json_path when set; false if that file can't be opened
+bool writeBenchReport(const CLIOptions& options, const std::function<void(std::ostream&)>& writer);
+
+// One benchmarked configuration over the measured frames
+struct BenchModeResult {
+    std::string label;
+    TimingStats submit, frame, gpu;
+    RenderCounters glCalls;
+    double samplesPassed = 0.0; // per frame
+
+    // Indented per-stage summary lines
+    void printSummary(unsigned int frames, std::ostream& os = std::cerr) const;
+    // The submit/frame/gpu/samples/gl_calls members of the mode's JSON object
+    void writeJsonFields(unsigned int frames, std::ostream& os) const;
+};
+
+struct BenchCamera {
+    glm::vec3 position;
+    glm::mat4 view;
+    glm::mat4 projection;
+};
+
+// Camera at `position` looking at the origin, y up, at the options' aspect ratio
+BenchCamera benchCameraAt(const CLIOptions& options, const glm::vec3& position, float fovDegrees, float farPlane);
+
+// Use `shader` with the camera and the benches' fixed light
+void useBenchShader(Shader& shader, const BenchCamera& camera);
+
+class BenchScene {
+public:
+    explicit BenchScene(const CLIOptions& options);
+    ~BenchScene();
+
+    BenchScene(const BenchScene&) = delete;
+    BenchScene& operator=(const BenchScene&) = delete;
+
+    // Headless context and GL state, the Earth, Moon and Spitfire models with their
+    // textures uploaded, and the frame queries
+    bool initialize(std::string& errMsg);
+
+    Model& earth() { return *earth_; }
+    Model& moon() { return *moon_; }
+    Model& spitfire() { return *spitfire_; }
+
+    // Render bench_warmup + bench_iterations frames. Each binds and clears the framebuffer,
+    // starts the GPU timer and samples-passed queries and calls draw(time, measured);
+    // submission time ends when draw returns. Measured frames are added to `result`.
+    void runFrames(BenchModeResult& result, const std::function<void(float time, bool measured)>& draw);
+
+    // From draw(): stop counting samples; GPU work submitted after this is still timed
+    void endSamplesPassed();
+
+private:
+    const CLIOptions& options_;
+    HeadlessContext ctx_;
+    std::unique_ptr<Model> earth_, moon_, spitfire_;
+    GLuint queries_[2] = {0, 0}; // time elapsed, samples passed
+    bool countingSamples_ = false;
+};
+
+#endif // BENCH_COMMON_HPP
@@ -0,0 +1,218 @@
+// Side-by-side detector benchmark: decodes a recorded clip into memory once,
+// then runs every inference engine over the same frames and reports per-stage
+// latency and how closely each engine's detections agree with the first one.
+// With int8_model_path set it also runs the quantized model and fails (exit 2)
+// if its detections drift too far from the FP32 model's.
+//
+//   ./MillDetectorBench --device_name clips/hands.mp4 --bench_iterations 300 \
+//                       --bench_json_path detectors.json
+
+#include "bench_common.hpp"
+
+#include <my_webcam.hpp>
+#include <my_hands.hpp>
+#include <my_cli.hpp>
+#include <my_timing.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One engine/model combination under test
+struct Variant {
+    std::string label;
+    InferenceEngine engine;
+    std::string modelPath;
+};
+
+struct VariantResult {
+    Variant variant;
+    std::string backend;
+    TimingStats preprocess, forward, postprocess, total;
+    std::vector<std::vector<HandResult>> detections; // per frame
+};
+
+static float iou(const cv::Rect& a, const cv::Rect& b) {
+    float inter = static_cast<float>((a & b).area());
+    float uni = static_cast<float>(a.area() + b.area()) - inter;
+    return uni > 0.0f ? inter / uni : 0.0f;
+}
+
+// Agreement of `test` with `reference`: frames with the same hand count, mean best IoU of reference hands
+static void compareDetections(const VariantResult& reference, const VariantResult& test,
+                              double& sameCountFraction, double& meanIou) {
+    size_t sameCount = 0, matched = 0;
+    double iouSum = 0.0;
+    for (size_t f = 0; f < reference.detections.size(); ++f) {
+        const auto& ref = reference.detections[f];
+        const auto& other = test.detections[f];
+        if (ref.size() == other.size()) ++sameCount;
+        for (const auto& r : ref) {
+            float best = 0.0f;
+            for (const auto& o : other) best = std::max(best, iou(r.roi, o.roi));
+            iouSum += best;
+            ++matched;
+        }
+    }
+    sameCountFraction = reference.detections.empty() ? 1.0 : static_cast<double>(sameCount) / reference.detections.size();
+    meanIou = matched ? iouSum / matched : 1.0;
+}
+
+// INT8 accuracy gate against the FP32 detections
+static const double INT8_MIN_SAME_COUNT = 0.90;
+static const double INT8_MIN_MEAN_IOU = 0.80;
+
+static bool runVariant(const CLIOptions& options, const std::vector<cv::Mat>& frames, VariantResult& result,
+                       std::string& err) {
+    HandTracker tracker;
+    tracker.setEngine(result.variant.engine, static_cast<int>(options.ortIntraOpThreads));
+    tracker.setFusion(options.dnnFusion);
+    // No smoothing: compare raw detections
+    if (!tracker.load(result.variant.modelPath, options.onnxInputSize, false, err)) {
+        return false;
+    }
+    std::vector<BackendCandidate> backends;
+    if (result.variant.engine == ENGINE_OPENCV_DNN
+        && (!parseBackendList(options.dnnBackends, backends, err)
+            || !tracker.selectBackend(backends, options.backendCachePath, err))) {
+        std::cerr << "Warning: backend selection failed: " << err << std::endl;
+    }
+    result.backend = tracker.backendName();
+
+    for (unsigned int i = 0; i < options.benchWarmup; ++i) {
+        tracker.infer(frames[i % frames.size()]);
+    }
+    result.detections.clear();
+    for (const cv::Mat& frame : frames) {
+        auto start = SteadyClock::now();
+        result.detections.push_back(tracker.infer(frame));
+        result.total.add(elapsedMs(start, SteadyClock::now()));
+        result.preprocess.add(tracker.lastTimings().preprocessMs);
+        result.forward.add(tracker.lastTimings().forwardMs);
+        result.postprocess.add(tracker.lastTimings().postprocessMs);
+    }
+    return true;
+}
+
+static void writeReport(std::ostream& os, const CLIOptions& options, size_t frameCount,
+                        const std::vector<VariantResult>& results) {
+    os << "{\n"
+       << "  \"benchmark\": \"detector\",\n"
+       << "  \"source\": \"" << options.deviceName << "\",\n"
+       << "  \"frames\": " << frameCount << ",\n"
+       << "  \"detector_input\": " << options.onnxInputSize << ",\n"
+       << "  \"variants\": [\n";
+    for (size_t v = 0; v < results.size(); ++v) {
+        const VariantResult& r = results[v];
+        double sameCount = 1.0, meanIou = 1.0;
+        compareDetections(results.front(), r, sameCount, meanIou);
+        os << "    {\"label\": \"" << r.variant.label << "\", \"model\": \"" << r.variant.modelPath
+           << "\", \"backend\": \"" << r.backend << "\",\n"
+           << "     \"preprocess_ms\": ";
+        r.preprocess.writeJson(os);
+        os << ",\n     \"forward_ms\": ";
+        r.forward.writeJson(os);
+        os << ",\n     \"postprocess_ms\": ";
+        r.postprocess.writeJson(os);
+        os << ",\n     \"total_ms\": ";
+        r.total.writeJson(os);
+        os << ",\n     \"same_hand_count_fraction\": " << sameCount << ", \"mean_iou_vs_first\": " << meanIou << "}"
+           << (v + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    CLIOptions options = parseCli(argc, argv);
+    if (options.show_help) {
+        printHelp(argv[0]);
+        return 0;
+    }
+
+    // Decode the clip once so every variant sees identical frames
+    std::unique_ptr<MyWebcam> source;
+    try {
+        source = std::make_unique<MyWebcam>(options.webcamName, options.deviceName,
+            options.screenWidth, options.screenHeight, options.fps);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    std::string errMsg;
+    std::vector<cv::Mat> frames;
+    cv::Mat frame;
+    while (frames.size() < options.benchIterations && source->readFrame(frame, errMsg) == 0) {
+        frames.push_back(frame.clone());
+    }
+    if (frames.empty()) {
+        std::cerr << "No frames read from " << options.deviceName << ": " << errMsg << std::endl;
+        return -1;
+    }
+    std::cerr << "Benchmarking on " << frames.size() << " frames" << std::endl;
+
+    std::vector<Variant> variants = {
+        {"opencv_dnn", ENGINE_OPENCV_DNN, options.onnxModelPath},
+    };
+    if (OrtDetector::available()) {
+        variants.push_back({"onnxruntime", ENGINE_ONNXRUNTIME, options.onnxModelPath});
+    } else {
+        std::cerr << "ONNX Runtime not built in; configure with -DMILL_WITH_ONNXRUNTIME=ON to compare" << std::endl;
+    }
+    InferenceEngine int8Engine = ENGINE_OPENCV_DNN;
+    if (!options.int8ModelPath.empty()) {
+        parseInferenceEngine(options.inferenceEngine, int8Engine);
+        variants.push_back({"int8", int8Engine, options.int8ModelPath});
+    }
+
+    std::vector<VariantResult> results;
+    for (const Variant& variant : variants) {
+        VariantResult result;
+        result.variant = variant;
+        if (!runVariant(options, frames, result, errMsg)) {
+            std::cerr << variant.label << ": " << errMsg << std::endl;
+            continue;
+        }
+        std::cerr << variant.label << " (" << result.backend << "):" << std::endl;
+        result.preprocess.printSummary("  preprocess", std::cerr);
+        result.forward.printSummary("  forward", std::cerr);
+        result.postprocess.printSummary("  postprocess", std::cerr);
+        result.total.printSummary("  total", std::cerr);
+        results.push_back(std::move(result));
+    }
+    if (results.empty()) {
+        return -1;
+    }
+
+    // Quantized model must find the same hands as the FP32 model on the same engine
+    int status = 0;
+    for (const VariantResult& r : results) {
+        if (r.variant.label != "int8") continue;
+        const VariantResult* fp32 = nullptr;
+        for (const VariantResult& other : results) {
+            if (other.variant.engine == r.variant.engine && other.variant.label != "int8") fp32 = &other;
+        }
+        if (!fp32) {
+            std::cerr << "INT8 vs FP32: no FP32 result on the same engine to compare against -> FAIL" << std::endl;
+            status = 2;
+            continue;
+        }
+        double sameCount = 0.0, meanIou = 0.0;
+        compareDetections(*fp32, r, sameCount, meanIou);
+        double speedup = r.forward.percentile(50.0) > 0.0
+            ? fp32->forward.percentile(50.0) / r.forward.percentile(50.0) : 0.0;
+        bool pass = sameCount >= INT8_MIN_SAME_COUNT && meanIou >= INT8_MIN_MEAN_IOU;
+        std::cerr << "INT8 vs FP32: same hand count on " << 100.0 * sameCount << "% of frames, mean IoU "
+            << meanIou << ", forward speedup " << speedup << "x -> " << (pass ? "PASS" : "FAIL") << std::endl;
+        if (!pass) status = 2;
+    }
+
+    auto report = [&](std::ostream& os) {
+        writeReport(os, options, frames.size(), results);
+    };
+    if (!writeBenchReport(options, report)) {
+        return -1;
+    }
+    return status;
+}
@@ -0,0 +1,104 @@
+// Microbenchmark for BoxNms (my_nms.hpp) against cv::dnn::NMSBoxes on
+// clustered detector-like candidates, at 10, 100 and 1000 boxes.
+//
+//   ./MillNmsBench [repeats]
+
+#include <my_nms.hpp>
+#include <my_timing.hpp>
+
+#include <opencv2/dnn.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Boxes jittered around a handful of "hands", like raw YOLO anchors
+static void makeCandidates(size_t count, std::mt19937& rng, BoxSoA& boxes,
+                           std::vector<cv::Rect>& rects, std::vector<float>& scores) {
+    std::uniform_real_distribution<float> centre(50.0f, 590.0f);
+    std::uniform_real_distribution<float> size(40.0f, 160.0f);
+    std::normal_distribution<float> jitter(0.0f, 6.0f);
+    std::uniform_real_distribution<float> conf(0.80f, 1.0f);
+
+    const size_t clusters = std::max<size_t>(1, count / 25);
+    std::vector<cv::Vec4f> seeds(clusters);
+    for (auto& s : seeds) s = cv::Vec4f(centre(rng), centre(rng), size(rng), size(rng));
+
+    boxes.clear();
+    rects.clear();
+    scores.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const cv::Vec4f& s = seeds[i % clusters];
+        float w = std::max(4.0f, s[2] + jitter(rng));
+        float h = std::max(4.0f, s[3] + jitter(rng));
+        cv::Rect r(cvRound(s[0] + jitter(rng) - 0.5f * w), cvRound(s[1] + jitter(rng) - 0.5f * h),
+                   cvRound(w), cvRound(h));
+        float c = conf(rng);
+        boxes.push((float)r.x, (float)r.y, (float)(r.x + r.width), (float)(r.y + r.height), c);
+        rects.push_back(r);
+        scores.push_back(c);
+    }
+}
+
+static void report(const char* label, size_t boxes, const TimingStats& stats, size_t kept) {
+    std::cout << "  " << label << " p50 " << stats.percentile(50.0) * 1000.0 << " us, p99 "
+        << stats.percentile(99.0) * 1000.0 << " us, kept " << kept << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int repeats = argc > 1 ? std::atoi(argv[1]) : 2000;
+    if (repeats <= 0) repeats = 2000;
+
+    const float iouThreshold = 0.3f;
+    const float scoreThreshold = 0.8f;
+    std::mt19937 rng(42);
+    BoxNms nms;
+    BoxSoA boxes;
+    std::vector<cv::Rect> rects;
+    std::vector<float> scores;
+    std::vector<int> keep, reference;
+    std::vector<float> keptScores;
+    bool allMatch = true;
+
+    for (size_t count : {10, 100, 1000}) {
+        makeCandidates(count, rng, boxes, rects, scores);
+        std::cout << count << " candidates:" << std::endl;
+        int reps = count >= 1000 ? std::max(1, repeats / 10) : repeats;
+
+        TimingStats cvStats;
+        for (int r = 0; r < reps; ++r) {
+            auto start = SteadyClock::now();
+            cv::dnn::NMSBoxes(rects, scores, scoreThreshold, iouThreshold, reference);
+            cvStats.add(elapsedMs(start, SteadyClock::now()));
+        }
+        report("cv::dnn::NMSBoxes ", count, cvStats, reference.size());
+
+        const struct { const char* label; NmsMode mode; } modes[] = {
+            {"BoxNms hard       ", NMS_HARD},
+            {"BoxNms soft linear", NMS_SOFT_LINEAR},
+            {"BoxNms soft gauss ", NMS_SOFT_GAUSSIAN},
+        };
+        for (const auto& m : modes) {
+            NmsParams params;
+            params.mode = m.mode;
+            params.iouThreshold = iouThreshold;
+            params.scoreThreshold = m.mode == NMS_HARD ? 0.0f : scoreThreshold;
+            TimingStats stats;
+            for (int r = 0; r < reps; ++r) {
+                auto start = SteadyClock::now();
+                nms.run(boxes, params, keep, keptScores);
+                stats.add(elapsedMs(start, SteadyClock::now()));
+            }
+            report(m.label, count, stats, keep.size());
+
+            // Hard NMS must keep exactly what OpenCV keeps
+            if (m.mode == NMS_HARD && keep != reference) {
+                std::cout << "  ** hard NMS differs from cv::dnn::NMSBoxes **" << std::endl;
+                allMatch = false;
+            }
+        }
+    }
+
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+// Occlusion culling benchmark: one Earth with bench_objects Moons and
+// Spitfires on random inclined orbits around it, rendered headlessly through
+// SceneBatch. Runs with no occlusion culling, with the analytic
+// sphere-behind-sphere test and with hardware occlusion queries, and reports
+// per frame the orbiters that pass the occlusion test, the mesh draws left
+// after frustum culling, CPU submission, frame and GPU time, GL calls and
+// samples passed as JSON.
+//
+//   ./MillOcclusionBench --bench_objects 2000 --bench_iterations 300 --bench_json_path occlusion.json
+
+#include "bench_common.hpp"
+
+#include <my_batch.hpp>
+#include <my_frustum.hpp>
+#include <my_occlusion.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+enum OcclusionMode { OCCLUSION_NONE, OCCLUSION_ANALYTIC, OCCLUSION_QUERIES };
+
+struct ModeResult {
+    BenchModeResult frames;
+    double unoccluded = 0.0; // orbiters per frame that passed the occlusion test
+    double meshDraws = 0.0;  // per frame, after frustum culling
+};
+
+// A circular orbit around the origin, tilted out of the XZ plane
+struct Orbit {
+    float radius;
+    float inclination; // radians about X
+    float node;        // radians about Y
+    float phase;
+    float speed;       // radians per second
+    float scale;
+};
+
+static glm::mat4 orbiterMatrix(const Orbit& orbit, float time) {
+    const float angle = orbit.phase + orbit.speed * time;
+    glm::mat4 m = glm::rotate(glm::mat4(1.0f), orbit.node, glm::vec3(0.0f, 1.0f, 0.0f));
+    m = glm::rotate(m, orbit.inclination, glm::vec3(1.0f, 0.0f, 0.0f));
+    m = glm::translate(m, glm::vec3(orbit.radius * std::cos(angle), 0.0f, orbit.radius * std::sin(angle)));
+    return glm::scale(m, glm::vec3(orbit.scale));
+}
+
+static void writeReport(std::ostream& os, const CLIOptions& options, const std::vector<ModeResult>& results) {
+    os << "{\n"
+       << "  \"benchmark\": \"occlusion\",\n"
+       << "  \"orbiters\": " << options.benchObjects << ",\n"
+       << "  \"frames\": " << options.benchIterations << ",\n"
+       << "  \"modes\": [\n";
+    for (size_t r = 0; r < results.size(); ++r) {
+        os << "    {\"label\": \"" << results[r].frames.label << "\", \"unoccluded_per_frame\": "
+           << results[r].unoccluded << ", \"mesh_draws_per_frame\": " << results[r].meshDraws << ",\n     ";
+        results[r].frames.writeJsonFields(options.benchIterations, os);
+        os << "}" << (r + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    CLIOptions options = parseCli(argc, argv);
+    if (options.show_help) {
+        printHelp(argv[0]);
+        return 0;
+    }
+
+    BenchScene scene(options);
+    std::string errMsg;
+    if (!scene.initialize(errMsg)) {
+        std::cerr << errMsg << std::endl;
+        return -1;
+    }
+    const Model& earth = scene.earth();
+    const Model* orbiterModels[2] = {&scene.moon(), &scene.spitfire()};
+
+    Shader shader(options.batchVertexShaderPath.c_str(), options.earthFragmentShaderPath.c_str());
+
+    // The Earth is scaled to unit radius at the origin; orbits fill the shell out to three radii,
+    // and the camera sits far enough back to see all of them
+    const float earthScale = 1.0f / std::max(earth.boundsRadius(), 1e-6f);
+    const glm::mat4 earthMatrix = glm::scale(glm::translate(glm::mat4(1.0f), -earthScale * earth.boundsCenter()),
+                                             glm::vec3(earthScale));
+    const glm::vec4 earthSphere = transformInnerSphere(earthMatrix, earth.boundsCenter(), earth.innerRadius());
+
+    const size_t orbiters = std::max(1u, options.benchObjects);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Orbit> orbits(orbiters);
+    for (size_t i = 0; i < orbiters; ++i) {
+        const Model& model = *orbiterModels[i % 2];
+        orbits[i] = {1.3f + 1.7f * unit(rng), (unit(rng) - 0.5f) * 3.1415927f, 6.2831853f * unit(rng),
+                     6.2831853f * unit(rng), 0.2f + 0.8f * unit(rng),
+                     (i % 2 ? 0.12f : 0.08f) / std::max(model.boundsRadius(), 1e-6f)};
+    }
+
+    const BenchCamera camera = benchCameraAt(options, glm::vec3(0.0f, 0.5f, 7.0f), 45.0f, 20.0f);
+    const Frustum frustum = Frustum::fromMatrix(camera.projection * camera.view);
+
+    SceneBatch batch;
+    batch.build({&earth, orbiterModels[0], orbiterModels[1]});
+
+    const OcclusionMode modes[] = {OCCLUSION_NONE, OCCLUSION_ANALYTIC, OCCLUSION_QUERIES};
+    const char* modeNames[] = {"none", "analytic", "queries"};
+    std::vector<glm::vec4> spheres(orbiters);
+    std::vector<ModeResult> results;
+    for (int mode = 0; mode < 3; ++mode) {
+        ModeResult result;
+        result.frames.label = modeNames[mode];
+        std::unique_ptr<OcclusionQueries> occlusionQueries;
+        if (modes[mode] == OCCLUSION_QUERIES) {
+            occlusionQueries = std::make_unique<OcclusionQueries>(options.occlusionVertexShaderPath,
+                                                                  options.occlusionFragmentShaderPath);
+        }
+        uint64_t unoccluded = 0, meshDraws = 0;
+
+        scene.runFrames(result.frames, [&](float time, bool measured) {
+            useBenchShader(shader, camera);
+
+            RenderCounters& counters = frameRenderCounters();
+            batch.clear();
+            batch.add(0, earthMatrix);
+            for (size_t i = 0; i < orbiters; ++i) {
+                const Model& model = *orbiterModels[i % 2];
+                const glm::mat4 transform = orbiterMatrix(orbits[i], time);
+                spheres[i] = transformSphere(transform, model.boundsCenter(), model.boundsRadius());
+                bool hidden = false;
+                if (modes[mode] != OCCLUSION_NONE) {
+                    hidden = modes[mode] == OCCLUSION_ANALYTIC
+                        ? sphereHiddenBySphere(camera.position, glm::vec3(earthSphere), earthSphere.w,
+                                               glm::vec3(spheres[i]), spheres[i].w)
+                        : !occlusionQueries->visible(i);
+                    ++counters.occlusionTested;
+                    if (hidden) ++counters.occlusionRejected;
+                }
+                if (hidden) continue;
+                batch.add(1 + static_cast<int>(i % 2), transform);
+                if (measured) ++unoccluded;
+            }
+            batch.cull(frustum);
+            batch.submit(shader, camera.view, DRAW_ORDER_FRONT_TO_BACK);
+            if (measured) meshDraws += batch.drawCount();
+            scene.endSamplesPassed();
+            if (occlusionQueries) occlusionQueries->issue(spheres, camera.view, camera.projection, camera.position);
+        });
+        const double iterations = options.benchIterations ? static_cast<double>(options.benchIterations) : 1.0;
+        result.unoccluded = static_cast<double>(unoccluded) / iterations;
+        result.meshDraws = static_cast<double>(meshDraws) / iterations;
+
+        std::cerr << result.frames.label << " (" << result.unoccluded << " of " << orbiters
+            << " orbiters past occlusion, " << result.meshDraws << " mesh draws after culling):" << std::endl;
+        result.frames.printSummary(options.benchIterations, std::cerr);
+        results.push_back(std::move(result));
+    }
+
+    auto report = [&](std::ostream& os) {
+        writeReport(os, options, results);
+    };
+    if (!writeBenchReport(options, report)) {
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,243 @@
+// End-to-end pipeline benchmark: drives capture -> inference -> render from a
+// recorded clip in headless mode and reports per-stage latency percentiles.
+//
+//   ./MillPipelineBench --device_name clip.mp4 --bench_iterations 1000 \
+//                       --bench_warmup 50 --bench_json_path run.json
+
+#include <glad/glad.h>
+
+#include "bench_common.hpp"
+
+#include <my_camera.hpp>
+#include <my_webcam.hpp>
+#include <my_hands.hpp>
+#include <my_cli.hpp>
+#include <my_bg_quad.hpp>
+#include <my_scene.hpp>
+#include <my_headless.hpp>
+#include <my_timing.hpp>
+#include <my_trace.hpp>
+#include <my_latency.hpp>
+#include <my_render_stats.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Stage names in pipeline order
+enum Stage { CAPTURE, DECODE, PREPROCESS, INFERENCE, POSTPROCESS, UPLOAD, DRAW, SWAP, TOTAL, NUM_STAGES };
+static const char* STAGE_NAMES[NUM_STAGES] = {
+    "capture", "decode", "preprocess", "inference", "postprocess", "upload", "draw", "swap", "total"
+};
+
+static void writeReport(std::ostream& os, const CLIOptions& options, const std::vector<TimingStats>& stages,
+                        const LatencyTracker& latency, double throughputFps, const HandTracker& tracker,
+                        double sceneLoadMs, const RenderCounters& glCalls) {
+    os << "{\n"
+       << "  \"benchmark\": \"pipeline\",\n"
+#ifdef NDEBUG
+       << "  \"build_type\": \"Release\",\n"
+#else
+       << "  \"build_type\": \"Debug\",\n"
+#endif
+       << "  \"compiler\": \"" << __VERSION__ << "\",\n"
+       << "  \"source\": \"" << options.deviceName << "\",\n"
+       << "  \"width\": " << options.screenWidth << ",\n"
+       << "  \"height\": " << options.screenHeight << ",\n"
+       << "  \"detector_model\": \"" << options.detectorModelPath() << "\",\n"
+       << "  \"detector_input\": " << options.onnxInputSize << ",\n"
+       << "  \"final_detector_input\": " << tracker.inputSize() << ",\n"
+       << "  \"dnn_backend\": \"" << tracker.backendName() << "\",\n"
+       << "  \"detector_warmup_runs\": " << options.detectorWarmupRuns << ",\n"
+       << "  \"detector_warmup_ms\": " << tracker.warmupMs() << ",\n"
+       << "  \"detector_cold_forward_ms\": " << tracker.coldForwardMs() << ",\n"
+       << "  \"first_inference_ms\": " << tracker.firstInferenceMs() << ",\n"
+       << "  \"warmup_frames\": " << options.benchWarmup << ",\n"
+       << "  \"iterations\": " << options.benchIterations << ",\n"
+       << "  \"throughput_fps\": " << throughputFps << ",\n"
+       << "  \"motion_gate\": " << (options.motionGate ? "true" : "false") << ",\n"
+       << "  \"detector_skipped_fraction\": " << tracker.motionGate().skippedFraction() << ",\n"
+       << "  \"tiled_detection\": " << (options.tiledDetection ? "true" : "false") << ",\n"
+       << "  \"tiles_per_frame\": " << tracker.tilePlanner().tilesPerFrame() << ",\n"
+       << "  \"texture_bytes\": " << TextureCache::instance().textureBytes() << ",\n"
+       << "  \"texture_cache_hits\": " << TextureCache::instance().hits() << ",\n"
+       << "  \"texture_cache_misses\": " << TextureCache::instance().misses() << ",\n"
+       << "  \"texture_streaming\": " << (options.textureStreaming ? "true" : "false") << ",\n"
+       << "  \"scene_load_ms\": " << sceneLoadMs << ",\n"
+       << "  \"textures_resident_ms\": " << TextureCache::instance().residentMs() << ",\n"
+       << "  \"gl_calls_per_frame\": ";
+    glCalls.writeJsonPerFrame(options.benchIterations, os);
+    os << ",\n"
+       << "  \"latency_ms\": ";
+    latency.writeJson(os);
+    os << ",\n"
+       << "  \"stages_ms\": {\n";
+    for (int s = 0; s < NUM_STAGES; ++s) {
+        os << "    \"" << STAGE_NAMES[s] << "\": ";
+        stages[s].writeJson(os);
+        os << (s + 1 < NUM_STAGES ? ",\n" : "\n");
+    }
+    os << "  }\n}\n";
+}
+
+int main(int argc, char** argv) {
+    CLIOptions options = parseCli(argc, argv);
+    if (options.show_help) {
+        printHelp(argv[0]);
+        return 0;
+    }
+    Tracer::setEnabled(options.traceEnabled);
+
+    // Offscreen GL context
+    HeadlessContext ctx(options.screenWidth, options.screenHeight);
+    std::string errMsg;
+    if (!ctx.initialize(errMsg)) {
+        std::cerr << "Failed to setup headless rendering: " << errMsg << std::endl;
+        return -1;
+    }
+    configureGLState();
+
+    // Same scene, camera and background as the app
+    TextureCache& textures = TextureCache::instance();
+    textures.setPreferCompressed(options.compressedTextures);
+    textures.setStreaming(options.textureStreaming);
+    textures.setUploadBudget(static_cast<size_t>(options.textureUploadBudgetKb) * 1024);
+    auto sceneStart = SteadyClock::now();
+    GlobeScene scene(options);
+    const double sceneLoadMs = elapsedMs(sceneStart, SteadyClock::now());
+    // Measure steady-state frames only: wait for the "all resident" point first
+    textures.finishUploads();
+    Camera camera;
+    camera.setPosition(options.initPosition);
+    camera.setZoom(options.cameraZoom);
+    BackgroundQuad bgQuad(options.bgVertexShaderPath, options.bgFragmentShaderPath);
+    bgQuad.initialize();
+
+    // Frame source (a recorded clip gives repeatable numbers)
+    std::unique_ptr<MyWebcam> source;
+    try {
+        source = std::make_unique<MyWebcam>(options.webcamName, options.deviceName,
+            options.screenWidth, options.screenHeight, options.fps);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    if (!source->isFile()) {
+        std::cerr << "Warning: benchmarking a live device; results depend on the scene" << std::endl;
+    }
+
+    // Same detector setup as the app, inference_cores included
+    HandTracker handTracker;
+    if (!configureHandTracker(handTracker, options, errMsg)) {
+        std::cerr << "HandTracker load failed: " << errMsg << std::endl;
+        return -1;
+    }
+
+    const glm::mat4 view = camera.getViewMatrix();
+    const glm::mat4 projection = glm::perspective(glm::radians(camera.zoom_),
+        static_cast<float>(options.screenWidth) / static_cast<float>(options.screenHeight), 0.1f, 1000.0f);
+    const float deltaTime = 1.0f / static_cast<float>(std::max(options.fps, 1u));
+
+    std::vector<TimingStats> stages(NUM_STAGES);
+    LatencyTracker latency;
+    RenderCounters glCalls;
+    cv::Mat frame;
+    const unsigned int totalFrames = options.benchWarmup + options.benchIterations;
+    SteadyClock::time_point measureStart = SteadyClock::now();
+    for (unsigned int i = 0; i < totalFrames; ++i) {
+        if (i == options.benchWarmup) {
+            measureStart = SteadyClock::now();
+        }
+        double t[NUM_STAGES] = {0.0};
+        FrameStamps stamps;
+        stamps.frameId = i;
+        auto frameStart = SteadyClock::now();
+
+        // Capture (loop the clip when it runs out)
+        auto stageStart = SteadyClock::now();
+        if (source->grabFrame(errMsg) != 0 && !(source->rewind() && source->grabFrame(errMsg) == 0)) {
+            std::cerr << "Frame source exhausted: " << errMsg << std::endl;
+            return -1;
+        }
+        t[CAPTURE] = elapsedMs(stageStart, SteadyClock::now());
+        stamps.captureNs = source->lastCaptureNs();
+
+        // Decode
+        stageStart = SteadyClock::now();
+        if (source->retrieveFrame(frame, errMsg) != 0) {
+            std::cerr << errMsg << std::endl;
+            return -1;
+        }
+        t[DECODE] = elapsedMs(stageStart, SteadyClock::now());
+
+        // Inference (stage split reported by the tracker)
+        std::vector<HandResult> hands = handTracker.infer(frame);
+        t[PREPROCESS] = handTracker.lastTimings().motionMs + handTracker.lastTimings().preprocessMs;
+        t[INFERENCE] = handTracker.lastTimings().forwardMs;
+        t[POSTPROCESS] = handTracker.lastTimings().postprocessMs;
+        stamps.detectNs = monotonicNowNs();
+        stamps.detectCaptureNs = stamps.captureNs;
+
+        // Texture upload
+        stageStart = SteadyClock::now();
+        bgQuad.updateTexture(frame);
+        t[UPLOAD] = elapsedMs(stageStart, SteadyClock::now());
+
+        // Scene draw (CPU submission; GPU time lands in the swap stage)
+        stageStart = SteadyClock::now();
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        bgQuad.render();
+        scene.update(deltaTime);
+        scene.followHands(hands, view, projection, options.screenWidth, options.screenHeight, frame.cols, frame.rows);
+        scene.draw(view, projection, camera.position_);
+        t[DRAW] = elapsedMs(stageStart, SteadyClock::now());
+        stamps.drawNs = monotonicNowNs();
+
+        // Swap stand-in: wait for the GPU
+        stageStart = SteadyClock::now();
+        ctx.finish();
+        t[SWAP] = elapsedMs(stageStart, SteadyClock::now());
+        t[TOTAL] = elapsedMs(frameStart, SteadyClock::now());
+        stamps.presentNs = monotonicNowNs();
+
+        if (i >= options.benchWarmup) {
+            latency.record(stamps);
+            latency.recordInference(stamps.detectCaptureNs, stamps.detectNs);
+            for (int s = 0; s < NUM_STAGES; ++s) {
+                stages[s].add(t[s]);
+            }
+            endRenderFrame(glCalls);
+        } else {
+            frameRenderCounters() = RenderCounters();
+        }
+    }
+    double measuredSec = elapsedMs(measureStart, SteadyClock::now()) / 1000.0;
+    double throughputFps = measuredSec > 0.0 ? options.benchIterations / measuredSec : 0.0;
+
+    if (Tracer::enabled() && !Tracer::dump(options.tracePath, errMsg)) {
+        std::cerr << errMsg << std::endl;
+    }
+
+    // Human readable summary on stderr, JSON on stdout or to file
+    for (int s = 0; s < NUM_STAGES; ++s) {
+        stages[s].printSummary(STAGE_NAMES[s], std::cerr);
+    }
+    latency.printSummary(std::cerr);
+    glCalls.printPerFrame(options.benchIterations, std::cerr);
+    std::cerr << "Throughput: " << throughputFps << " fps" << std::endl;
+    const double skippedFraction = handTracker.motionGate().skippedFraction();
+    if (options.motionGate) {
+        std::cerr << "Detector skipped on " << 100.0 * skippedFraction << "% of frames" << std::endl;
+    }
+
+    auto report = [&](std::ostream& os) {
+        writeReport(os, options, stages, latency, throughputFps, handTracker, sceneLoadMs, glCalls);
+    };
+    if (!writeBenchReport(options, report)) {
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+// Draw submission stress test: bench_objects Earths, Moons and Spitfires in
+// overlapping layers, rendered headlessly mesh by mesh through a RenderQueue
+// (the unbatched path) and through SceneBatch on each path the context
+// supports, each with no depth sort, front-to-back and back-to-front. Reports
+// CPU submission, whole-frame and GPU time, GL calls and the fragments that
+// passed the depth test (those are the ones shaded) per frame as JSON.
+//
+//   ./MillSceneBench --bench_objects 1000 --bench_iterations 300 --bench_json_path scene.json
+
+#include "bench_common.hpp"
+
+#include <my_batch.hpp>
+#include <my_render_queue.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+enum SubmitMode { SUBMIT_DIRECT, SUBMIT_BATCHED_INSTANCED, SUBMIT_BATCHED_INDIRECT };
+
+// Depth layers; each hides most of the ones behind it
+static const size_t LAYERS = 4;
+
+// Object i on a square grid facing the camera, model i % 3, each spinning at its own rate
+static glm::mat4 objectMatrix(size_t i, size_t perRow, float time) {
+    const float spacing = 1.2f;
+    const size_t cell = i / LAYERS;
+    float x = (static_cast<float>(cell % perRow) - 0.5f * (perRow - 1)) * spacing;
+    float y = (static_cast<float>(cell / perRow) - 0.5f * (perRow - 1)) * spacing;
+    float z = -1.5f * static_cast<float>(i % LAYERS);
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, z));
+    m = glm::rotate(m, time * (0.5f + 0.01f * static_cast<float>(i % 50)), glm::vec3(0.0f, 1.0f, 0.0f));
+    return glm::scale(m, glm::vec3(i % 3 == 2 ? 0.15f : 0.5f));
+}
+
+static glm::mat4 propellerTransform(const CLIOptions& options, float time, const std::string& meshName) {
+    std::string lower = meshName;
+    for (char& c : lower) c = static_cast<char>(::tolower(c));
+    if (lower.find("prop") == std::string::npos) return glm::mat4(1.0f);
+    return glm::rotate(glm::mat4(1.0f), 6.2831853f * options.propellerRps * time, options.propellerAxis);
+}
+
+static void writeReport(std::ostream& os, const CLIOptions& options, const std::vector<BenchModeResult>& results) {
+    os << "{\n"
+       << "  \"benchmark\": \"scene_submission\",\n"
+       << "  \"objects\": " << options.benchObjects << ",\n"
+       << "  \"frames\": " << options.benchIterations << ",\n"
+       << "  \"layers\": " << LAYERS << ",\n"
+       << "  \"modes\": [\n";
+    for (size_t r = 0; r < results.size(); ++r) {
+        os << "    {\"label\": \"" << results[r].label << "\",\n     ";
+        results[r].writeJsonFields(options.benchIterations, os);
+        os << "}" << (r + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    CLIOptions options = parseCli(argc, argv);
+    if (options.show_help) {
+        printHelp(argv[0]);
+        return 0;
+    }
+
+    BenchScene scene(options);
+    std::string errMsg;
+    if (!scene.initialize(errMsg)) {
+        std::cerr << errMsg << std::endl;
+        return -1;
+    }
+    Model* models[3] = {&scene.earth(), &scene.moon(), &scene.spitfire()};
+
+    Shader directShader(options.earthVertexShaderPath.c_str(), options.earthFragmentShaderPath.c_str());
+    Shader batchShader(options.batchVertexShaderPath.c_str(), options.earthFragmentShaderPath.c_str());
+
+    // Camera pulled back far enough to see the whole grid
+    const size_t objects = std::max(1u, options.benchObjects);
+    const size_t perRow = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>((objects + LAYERS - 1) / LAYERS))));
+    const float distance = 1.2f * static_cast<float>(perRow) + 2.0f;
+    const BenchCamera camera = benchCameraAt(options, glm::vec3(0.0f, 0.0f, distance), 60.0f, 4.0f * distance);
+    const glm::mat4& view = camera.view;
+
+    std::vector<SubmitMode> modes = {SUBMIT_DIRECT, SUBMIT_BATCHED_INSTANCED};
+    if (GLAD_GL_VERSION_4_3) {
+        modes.push_back(SUBMIT_BATCHED_INDIRECT);
+    } else {
+        std::cerr << "No GL 4.3: skipping multi-draw indirect" << std::endl;
+    }
+
+    const DrawOrder orders[] = {DRAW_ORDER_NONE, DRAW_ORDER_FRONT_TO_BACK, DRAW_ORDER_BACK_TO_FRONT};
+    const char* orderNames[] = {"none", "front_to_back", "back_to_front"};
+
+    // Unbatched path: (object, mesh) pairs through the render queue
+    struct MeshDraw {
+        size_t object;
+        size_t mesh;
+    };
+    std::vector<MeshDraw> meshDraws;
+    RenderQueue queue;
+
+    std::vector<BenchModeResult> results;
+    for (size_t run = 0; run < modes.size() * 3; ++run) {
+        const SubmitMode mode = modes[run / 3];
+        const DrawOrder order = orders[run % 3];
+        BenchModeResult result;
+        result.label = std::string(mode == SUBMIT_DIRECT ? "direct" : mode == SUBMIT_BATCHED_INSTANCED
+            ? "batched_instanced" : "batched_indirect") + "/" + orderNames[run % 3];
+        SceneBatch batch;
+        if (mode != SUBMIT_DIRECT) {
+            batch.build({models[0], models[1], models[2]}, mode == SUBMIT_BATCHED_INDIRECT);
+        }
+        Shader& shader = mode == SUBMIT_DIRECT ? directShader : batchShader;
+
+        scene.runFrames(result, [&](float time, bool) {
+            useBenchShader(shader, camera);
+            auto props = [&](const std::string& meshName) { return propellerTransform(options, time, meshName); };
+
+            if (mode == SUBMIT_DIRECT) {
+                meshDraws.clear();
+                queue.clear();
+                for (size_t i = 0; i < objects; ++i) {
+                    const glm::mat4 transform = objectMatrix(i, perRow, time);
+                    for (size_t m = 0; m < models[i % 3]->meshes().size(); ++m) {
+                        const Mesh& mesh = models[i % 3]->meshes()[m];
+                        const glm::mat4 meshModel = i % 3 == 2 ? props(mesh.meshName_) : glm::mat4(1.0f);
+                        float depth = -(view * transform * meshModel * glm::vec4(mesh.boundsCenter(), 1.0f)).z;
+                        queue.push(RenderQueue::makeKey(RenderQueue::PASS_OPAQUE, shader.ID_, mesh.textureSetKey(),
+                                                        RenderQueue::depthBucket(depth, order)),
+                                   static_cast<uint32_t>(meshDraws.size()));
+                        meshDraws.push_back({i, m});
+                    }
+                }
+                queue.sort();
+                size_t currentObject = objects;
+                for (size_t k = 0; k < queue.size(); ++k) {
+                    const MeshDraw& draw = meshDraws[queue.item(k)];
+                    const glm::mat4 transform = objectMatrix(draw.object, perRow, time);
+                    if (draw.object != currentObject) {
+                        shader.setMat4("model", transform);
+                        currentObject = draw.object;
+                    }
+                    Model* model = models[draw.object % 3];
+                    const glm::mat4 meshModel = draw.object % 3 == 2
+                        ? props(model->meshes()[draw.mesh].meshName_) : glm::mat4(1.0f);
+                    model->drawMesh(shader, draw.mesh, meshModel);
+                }
+            } else {
+                batch.clear();
+                for (size_t i = 0; i < objects; ++i) {
+                    if (i % 3 == 2) {
+                        batch.add(2, objectMatrix(i, perRow, time), props);
+                    } else {
+                        batch.add(static_cast<int>(i % 3), objectMatrix(i, perRow, time));
+                    }
+                }
+                batch.submit(shader, view, order);
+            }
+        });
+
+        std::cerr << result.label << " (" << objects << " objects";
+        if (mode != SUBMIT_DIRECT) std::cerr << ", " << batch.apiCalls() << " draw calls for " << batch.drawCount() << " draws";
+        std::cerr << "):" << std::endl;
+        result.printSummary(options.benchIterations, std::cerr);
+        results.push_back(std::move(result));
+    }
+
+    auto report = [&](std::ostream& os) {
+        writeReport(os, options, results);
+    };
+    if (!writeBenchReport(options, report)) {
+        return -1;
+    }
+    return 0;
+}
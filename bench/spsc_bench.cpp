@@ -0,0 +1,125 @@
+// Contention microbenchmark for the SPSC primitives in my_spsc.hpp versus a
+// mutex-protected std::deque, with one producer and one consumer thread.
+//
+//   ./MillSpscBench [items]
+
+#include <my_spsc.hpp>
+#include <my_timing.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// Mutex baseline with the same try-push/try-pop interface
+template <typename T, size_t Capacity>
+class MutexQueue
+{
+public:
+    bool tryPush(const T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.size() == Capacity) return false;
+        items_.push_back(value);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.empty()) return false;
+        value = items_.front();
+        items_.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<T> items_;
+};
+
+// Push `items` sequence numbers through the queue; returns ms, verifies ordering
+template <typename Queue>
+static double runQueue(Queue& queue, uint64_t items, bool& ordered) {
+    auto start = SteadyClock::now();
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < items; ++i) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    ordered = true;
+    uint64_t expected = 0, value = 0;
+    while (expected < items) {
+        if (queue.tryPop(value)) {
+            ordered = ordered && (value == expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    return elapsedMs(start, SteadyClock::now());
+}
+
+// Producer publishes `items` values as fast as it can; consumer keeps up with the newest
+static double runLatestSlot(uint64_t items, uint64_t& observed, bool& monotonic) {
+    LatestSlot<uint64_t> slot;
+    std::atomic<bool> done{false};
+    auto start = SteadyClock::now();
+    std::thread producer([&]() {
+        for (uint64_t i = 1; i <= items; ++i) {
+            slot.writeBuffer() = i;
+            slot.publish();
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    observed = 0;
+    monotonic = true;
+    uint64_t last = 0;
+    while (!done.load(std::memory_order_acquire) || last != items) {
+        if (slot.update()) {
+            uint64_t v = slot.readBuffer();
+            monotonic = monotonic && (v > last);
+            last = v;
+            ++observed;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    return elapsedMs(start, SteadyClock::now());
+}
+
+static void report(const char* label, uint64_t items, double ms, bool ok) {
+    std::cout << label << ": " << items << " items in " << ms << " ms ("
+        << (ms > 0.0 ? items / (ms * 1000.0) : 0.0) << " Mitems/s)"
+        << (ok ? "" : "  ** ORDER VIOLATION **") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    uint64_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000ULL;
+    bool ok = true, allOk = true;
+
+    static SpscQueue<uint64_t, 1024> spsc;
+    double ms = runQueue(spsc, items, ok);
+    report("SpscQueue<1024>      ", items, ms, ok);
+    allOk = allOk && ok;
+
+    static MutexQueue<uint64_t, 1024> locked;
+    ms = runQueue(locked, items, ok);
+    report("mutex + std::deque   ", items, ms, ok);
+    allOk = allOk && ok;
+
+    uint64_t observed = 0;
+    ms = runLatestSlot(items, observed, ok);
+    report("LatestSlot publish   ", items, ms, ok);
+    std::cout << "  consumer observed " << observed << " distinct values (newest always reached)" << std::endl;
+    allOk = allOk && ok;
+
+    return allOk ? 0 : 1;
+}
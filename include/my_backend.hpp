@@ -0,0 +1,40 @@
+#ifndef MY_BACKEND_HPP
+#define MY_BACKEND_HPP
+
+#include <string>
+#include <vector>
+
+// Runtime that executes the detector network
+enum InferenceEngine {
+    ENGINE_OPENCV_DNN,   // cv::dnn, backend chosen by HandTracker::selectBackend
+    ENGINE_ONNXRUNTIME   // ONNX Runtime CPU execution provider (MILL_WITH_ONNXRUNTIME builds)
+};
+
+// "opencv" or "onnxruntime"
+bool parseInferenceEngine(const std::string& name, InferenceEngine& engine);
+
+// One OpenCV DNN backend/target combination to try for the detector
+struct BackendCandidate {
+    std::string name;  // e.g. "cuda_fp16"
+    int backend;       // cv::dnn::Backend
+    int target;        // cv::dnn::Target
+};
+
+// Parse a comma separated list of candidate names, in order of preference:
+//   cuda, cuda_fp16, openvino, opencl, opencl_fp16, cpu_fp16 (OpenCV 4.9+), cpu
+// Unknown or unsupported names are skipped with a warning; false only if none are left.
+bool parseBackendList(const std::string& spec, std::vector<BackendCandidate>& candidates, std::string& err);
+
+// Identifies this machine's inference stack (host, CPU, OpenCV build, GPUs) for cache keys
+std::string backendMachineId();
+
+// 64-bit FNV-1a of a file's contents as hex; false if it cannot be read
+bool hashFile(const std::string& path, std::string& hexDigest, std::string& err);
+std::string hashString(const std::string& data);
+
+// Persisted backend choices, keyed by model hash + machine id
+bool loadCachedBackend(const std::string& cachePath, const std::string& key, std::string& backendName);
+bool storeCachedBackend(const std::string& cachePath, const std::string& key,
+                        const std::string& backendName, double forwardMs, std::string& err);
+
+#endif // MY_BACKEND_HPP
@@ -0,0 +1,107 @@
+#ifndef MY_BATCH_HPP
+#define MY_BATCH_HPP
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <my_frustum.hpp>
+#include <my_model.hpp>
+#include <my_render_queue.hpp>
+#include <my_shader.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Whole-scene submission from shared buffers, one instanced draw per mesh (shaders/batch_shader.vs)
+class SceneBatch {
+public:
+    SceneBatch() = default;
+    ~SceneBatch();
+
+    SceneBatch(const SceneBatch&) = delete;
+    SceneBatch& operator=(const SceneBatch&) = delete;
+
+    // Copy the models' geometry into the shared buffers; handles are indices into `models`.
+    // allowIndirect = false forces the GL 3.3 path even on a 4.3+ context.
+    void build(const std::vector<const Model*>& models, bool allowIndirect = true);
+
+    // Start a frame's draw list
+    void clear();
+
+    // Draw every mesh of model `handle` with `transform`
+    void add(int handle, const glm::mat4& transform);
+    // ... with an extra per-mesh transform by mesh name (spinning propellers)
+    void add(int handle, const glm::mat4& transform,
+             const std::function<glm::mat4(const std::string&)>& meshTransform);
+
+    // Drop this frame's copies whose bounding sphere is outside `frustum`; returns how many
+    size_t cull(const Frustum& frustum);
+
+    // Issue the frame's draws with `shader` (already in use, view/projection/lighting set).
+    // The copies of each mesh are drawn in `order` by their depth under `view`.
+    void submit(Shader& shader, const glm::mat4& view, DrawOrder order = DRAW_ORDER_NONE);
+
+    bool indirect() const { return indirect_; }
+    size_t drawCount() const { return drawCount_; }   // (object, mesh) pairs last submit
+    size_t apiCalls() const { return apiCalls_; }     // draw calls issued last submit
+
+    // Texture unit the per-draw matrices are bound to (mesh textures use the units below it)
+    static const int DRAW_DATA_UNIT = 7;
+
+private:
+    // One mesh of one model, at its place in the shared buffers
+    struct BatchMesh {
+        GLsizei indexCount = 0;
+        GLuint firstIndex = 0;
+        GLint baseVertex = 0;
+        std::string name;
+        glm::vec3 center{0.0f};           // bounding sphere, mesh space
+        float radius = 0.0f;
+        std::vector<Texture> textures;
+        std::vector<glm::mat4> instances; // this frame's transforms
+    };
+
+    // Meshes sharing a texture set, contiguous in order_
+    struct TextureGroup {
+        std::vector<Texture> textures;
+        size_t first = 0;
+        size_t count = 0;
+    };
+
+    // Matches glMultiDrawElementsIndirect's command layout
+    struct DrawCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    std::vector<BatchMesh> meshes_;
+    std::vector<size_t> modelFirstMesh_;   // per handle, into meshes_; one past the end appended
+    std::vector<size_t> order_;            // meshes_ sorted by texture set
+    std::vector<TextureGroup> groups_;
+    std::vector<DrawCommand> commands_;    // in order_
+    std::vector<glm::mat4> drawData_;      // per draw, in command order
+    RenderQueue instanceQueue_;            // one mesh's copies by depth
+    SphereCuller culler_;                  // every copy of every mesh, in meshes_ order
+
+    bool indirect_ = false;
+    GLuint VAO_ = 0, VBO_ = 0, EBO_ = 0;
+    GLuint drawIdBuffer_ = 0;              // 0, 1, 2, ... read per instance
+    size_t drawIdCapacity_ = 0;
+    GLuint drawDataBuffer_ = 0, drawDataTexture_ = 0;
+    GLuint indirectBuffer_ = 0;
+    size_t drawCount_ = 0;
+    size_t apiCalls_ = 0;
+
+    void ensureDrawIds_(size_t count);
+    void pointDrawIds_(size_t first);
+    void bindTextures_(Shader& shader, const std::vector<Texture>& textures);
+    void deleteBuffers_();
+};
+
+#endif // MY_BATCH_HPP
@@ -0,0 +1,34 @@
+#ifndef MY_BCN_HPP
+#define MY_BCN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// S3TC block compression for the offline texture tool. Each 4x4 texel block
+// becomes 8 bytes (BC1: RGB, 4 bpp) or 16 bytes (BC3: BC1 colour plus an
+// interpolated alpha block, 8 bpp).
+enum BlockFormat {
+    BLOCK_BC1,
+    BLOCK_BC3
+};
+
+inline size_t blockBytes(BlockFormat format) { return format == BLOCK_BC1 ? 8 : 16; }
+
+// Bytes of one compressed mip level
+inline size_t compressedLevelBytes(BlockFormat format, int width, int height) {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes(format);
+}
+
+// One 4x4 block of RGBA8 texels (64 bytes, row-major) -> 8 / 16 bytes
+void compressBc1Block(const uint8_t* rgba, uint8_t* out);
+void compressBc3Block(const uint8_t* rgba, uint8_t* out);
+
+// Whole RGBA8 image; edge blocks of sizes that are not multiples of 4 repeat the last row/column
+void compressImage(const uint8_t* rgba, int width, int height, BlockFormat format, std::vector<uint8_t>& out);
+
+// Next mip level of an RGBA8 image (2x2 box filter, odd edges clamped)
+void downsampleRgba(const uint8_t* rgba, int width, int height, std::vector<uint8_t>& out,
+                    int& outWidth, int& outHeight);
+
+#endif // MY_BCN_HPP
@@ -2,7 +2,9 @@
 #define MY_CLI_HPP
 
 #include <glm/glm.hpp>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 struct CLIOptions {
@@ -17,8 +19,36 @@ struct CLIOptions {
 
     // ONNX yolo model params
     std::string onnxModelPath{"models/yolo11s_hand.onnx"};
+    std::string int8ModelPath{""};         // statically quantized variant of onnxModelPath
+    std::string detectorPrecision{"fp32"}; // fp32 or int8
     unsigned int onnxInputSize{640};
+    std::string detectorSizes{""};  // e.g. "640,480,320"; empty = fixed onnx_input_size
+    float detectorBudgetMs{0.0f};   // adaptive size target, 0 = off
     bool applySmoothing{true};
+    std::string inferenceEngine{"opencv"}; // opencv or onnxruntime
+    unsigned int ortIntraOpThreads{0};     // 0 = ONNX Runtime default
+    std::string dnnBackends{"cuda,openvino,cpu"}; // candidates, fastest matching one wins
+    std::string backendCachePath{"backend_cache.yaml"}; // empty = always benchmark
+    bool dnnFusion{false};
+    unsigned int detectorWarmupRuns{3}; // background forwards before the first frame, 0 = off
+    std::string nmsMode{"hard"}; // hard, soft_linear or soft_gaussian
+    float nmsIouThreshold{0.3f};
+    float nmsSigma{0.5f};        // soft_gaussian decay width
+    bool motionGate{false};      // skip the detector on static frames
+    float motionThreshold{2.0f}; // mean grey-level change that counts as motion
+    unsigned int motionMaxAge{30}; // run the detector at least every N frames
+    bool tiledDetection{false};    // full-resolution tiles around tracks and motion
+    unsigned int tileSize{0};      // tile side in frame pixels, 0 = detector input size
+    float tileOverlap{0.25f};
+    unsigned int maxTiles{4};      // tiles per frame on top of the whole-frame pass
+    float tileMotionThreshold{4.0f};
+
+    // Threading params
+    unsigned int inferenceThreads{0}; // OpenCV worker threads, 0 = OpenCV default
+    std::string captureCores{""};     // core list, e.g. "0" or "2-3"; empty = unpinned
+    std::string inferenceCores{""};
+    std::string renderCores{""};
+    int capturePriority{0};           // SCHED_FIFO priority for capture, 0 = unchanged
 
     // Virtual camera params
     float cameraSpeed{3.0f};
@@ -29,6 +59,15 @@ struct CLIOptions {
     // Earth model params
     std::string earthModelPath{"3d_models/earth.obj"};
     float earthScale{0.8f};
+    bool compressedTextures{true}; // prefer <texture>.ktx2 siblings written by MillCompressTexture
+    bool textureStreaming{true}; // placeholder textures at startup, decoded and uploaded in the background
+    unsigned int textureUploadBudgetKb{4096}; // streamed texture bytes uploaded per frame
+    bool keepMeshData{false}; // keep vertex/index vectors in RAM after upload to GL buffers
+    bool batchedSubmission{true}; // whole scene from one shared buffer, multi-draw indirect on GL 4.3+
+    std::string drawOrder{"front_to_back"}; // none, front_to_back or back_to_front within each material
+    bool frustumCulling{true}; // skip meshes whose bounding sphere is outside the view frustum
+    bool occlusionCulling{true}; // skip orbiters entirely behind the Earth (analytic sphere test)
+    bool occlusionQueries{false}; // also skip orbiters whose bounding box drew no samples a frame ago
 
     // Moon model params
     std::string moonModelPath{"3d_models/moon.obj"};
@@ -49,11 +88,51 @@ struct CLIOptions {
     std::string earthFragmentShaderPath{"shaders/earth_shader.fs"};
     std::string bgVertexShaderPath{"shaders/bg_quad.vs"};
     std::string bgFragmentShaderPath{"shaders/bg_quad.fs"};
+    std::string batchVertexShaderPath{"shaders/batch_shader.vs"}; // per-draw matrices, used with earth_fragment_shader_path
+    std::string occlusionVertexShaderPath{"shaders/occlusion_box.vs"}; // bounding boxes for occlusion_queries
+    std::string occlusionFragmentShaderPath{"shaders/occlusion_box.fs"};
+
+    // Headless (offscreen) rendering params
+    bool headless{false};
+    unsigned int headlessFrames{300};
+    std::string headlessOutput{""}; // PNG of the final frame, empty = none
+
+    // Trace instrumentation params
+    bool traceEnabled{false};
+    std::string tracePath{"trace.json"};
+
+    // Latency measurement params
+    bool latencyReport{false};
+
+    // Benchmark params (device_name may point at a recorded clip)
+    unsigned int benchIterations{500};
+    unsigned int benchWarmup{30};
+    std::string benchJsonPath{"bench_pipeline.json"}; // empty = print JSON to stdout
+    unsigned int benchObjects{500}; // models drawn per frame by MillSceneBench
 
     // Other CLI params
     std::string configPath{"config/config.yaml"}; // Default config path
     bool show_help{false};
 
+    // Detector model for the configured precision
+    const std::string& detectorModelPath() const {
+        return detectorPrecision == "int8" && !int8ModelPath.empty() ? int8ModelPath : onnxModelPath;
+    }
+
+    // Detector input sizes listed in detector_sizes (invalid entries skipped)
+    std::vector<int> detectorSizeList() const {
+        std::vector<int> sizes;
+        std::stringstream ss(detectorSizes);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            try {
+                sizes.push_back(std::stoi(item));
+            } catch (...) {
+            }
+        }
+        return sizes;
+    }
+
     // Load defaults from config.yaml
     void loadDefaults() {
         YAML::Node config = YAML::LoadFile(configPath);
@@ -69,8 +148,36 @@ struct CLIOptions {
 
         // ONNX yolo model params
         if (config["onnx_input_size"]) onnxInputSize = config["onnx_input_size"].as<unsigned int>();
+        if (config["detector_sizes"]) detectorSizes = config["detector_sizes"].as<std::string>();
+        if (config["detector_budget_ms"]) detectorBudgetMs = config["detector_budget_ms"].as<float>();
         if (config["apply_smoothing"]) applySmoothing = config["apply_smoothing"].as<bool>();
         if (config["model_path"]) onnxModelPath = config["model_path"].as<std::string>();
+        if (config["int8_model_path"]) int8ModelPath = config["int8_model_path"].as<std::string>();
+        if (config["detector_precision"]) detectorPrecision = config["detector_precision"].as<std::string>();
+        if (config["inference_engine"]) inferenceEngine = config["inference_engine"].as<std::string>();
+        if (config["ort_intra_op_threads"]) ortIntraOpThreads = config["ort_intra_op_threads"].as<unsigned int>();
+        if (config["dnn_backends"]) dnnBackends = config["dnn_backends"].as<std::string>();
+        if (config["backend_cache_path"]) backendCachePath = config["backend_cache_path"].as<std::string>();
+        if (config["dnn_fusion"]) dnnFusion = config["dnn_fusion"].as<bool>();
+        if (config["detector_warmup_runs"]) detectorWarmupRuns = config["detector_warmup_runs"].as<unsigned int>();
+        if (config["nms_mode"]) nmsMode = config["nms_mode"].as<std::string>();
+        if (config["nms_iou_threshold"]) nmsIouThreshold = config["nms_iou_threshold"].as<float>();
+        if (config["nms_sigma"]) nmsSigma = config["nms_sigma"].as<float>();
+        if (config["motion_gate"]) motionGate = config["motion_gate"].as<bool>();
+        if (config["motion_threshold"]) motionThreshold = config["motion_threshold"].as<float>();
+        if (config["motion_max_age"]) motionMaxAge = config["motion_max_age"].as<unsigned int>();
+        if (config["tiled_detection"]) tiledDetection = config["tiled_detection"].as<bool>();
+        if (config["tile_size"]) tileSize = config["tile_size"].as<unsigned int>();
+        if (config["tile_overlap"]) tileOverlap = config["tile_overlap"].as<float>();
+        if (config["max_tiles"]) maxTiles = config["max_tiles"].as<unsigned int>();
+        if (config["tile_motion_threshold"]) tileMotionThreshold = config["tile_motion_threshold"].as<float>();
+
+        // Threading params
+        if (config["inference_threads"]) inferenceThreads = config["inference_threads"].as<unsigned int>();
+        if (config["capture_cores"]) captureCores = config["capture_cores"].as<std::string>();
+        if (config["inference_cores"]) inferenceCores = config["inference_cores"].as<std::string>();
+        if (config["render_cores"]) renderCores = config["render_cores"].as<std::string>();
+        if (config["capture_priority"]) capturePriority = config["capture_priority"].as<int>();
 
         // Virtual camera params
         if (config["camera_speed"]) cameraSpeed = config["camera_speed"].as<float>();
@@ -86,6 +193,15 @@ struct CLIOptions {
         // Earth model params
         if (config["earth_model_path"]) earthModelPath = config["earth_model_path"].as<std::string>();
         if (config["earth_scale"]) earthScale = config["earth_scale"].as<float>();
+        if (config["compressed_textures"]) compressedTextures = config["compressed_textures"].as<bool>();
+        if (config["texture_streaming"]) textureStreaming = config["texture_streaming"].as<bool>();
+        if (config["texture_upload_budget_kb"]) textureUploadBudgetKb = config["texture_upload_budget_kb"].as<unsigned int>();
+        if (config["keep_mesh_data"]) keepMeshData = config["keep_mesh_data"].as<bool>();
+        if (config["batched_submission"]) batchedSubmission = config["batched_submission"].as<bool>();
+        if (config["draw_order"]) drawOrder = config["draw_order"].as<std::string>();
+        if (config["frustum_culling"]) frustumCulling = config["frustum_culling"].as<bool>();
+        if (config["occlusion_culling"]) occlusionCulling = config["occlusion_culling"].as<bool>();
+        if (config["occlusion_queries"]) occlusionQueries = config["occlusion_queries"].as<bool>();
 
         // Moon model params
         if (config["moon_model_path"]) moonModelPath = config["moon_model_path"].as<std::string>();
@@ -110,6 +226,27 @@ struct CLIOptions {
         if (config["earth_fragment_shader_path"]) earthFragmentShaderPath = config["earth_fragment_shader_path"].as<std::string>();
         if (config["bg_vertex_shader_path"]) bgVertexShaderPath = config["bg_vertex_shader_path"].as<std::string>();
         if (config["bg_fragment_shader_path"]) bgFragmentShaderPath = config["bg_fragment_shader_path"].as<std::string>();
+        if (config["batch_vertex_shader_path"]) batchVertexShaderPath = config["batch_vertex_shader_path"].as<std::string>();
+        if (config["occlusion_vertex_shader_path"]) occlusionVertexShaderPath = config["occlusion_vertex_shader_path"].as<std::string>();
+        if (config["occlusion_fragment_shader_path"]) occlusionFragmentShaderPath = config["occlusion_fragment_shader_path"].as<std::string>();
+
+        // Headless rendering params
+        if (config["headless"]) headless = config["headless"].as<bool>();
+        if (config["headless_frames"]) headlessFrames = config["headless_frames"].as<unsigned int>();
+        if (config["headless_output"]) headlessOutput = config["headless_output"].as<std::string>();
+
+        // Trace instrumentation params
+        if (config["trace_enabled"]) traceEnabled = config["trace_enabled"].as<bool>();
+        if (config["trace_path"]) tracePath = config["trace_path"].as<std::string>();
+
+        // Latency measurement params
+        if (config["latency_report"]) latencyReport = config["latency_report"].as<bool>();
+
+        // Benchmark params
+        if (config["bench_iterations"]) benchIterations = config["bench_iterations"].as<unsigned int>();
+        if (config["bench_warmup"]) benchWarmup = config["bench_warmup"].as<unsigned int>();
+        if (config["bench_json_path"]) benchJsonPath = config["bench_json_path"].as<std::string>();
+        if (config["bench_objects"]) benchObjects = config["bench_objects"].as<unsigned int>();
     }
 };
 
@@ -122,13 +259,48 @@ struct CLIOptions {
 //   --fps <int>
 //   --onnx_model_path <string>
 //   --onnx_input_size <int>
+//   --detector_sizes <int,int,...>
+//   --detector_budget_ms <float>
+//   --int8_model_path <string>
+//   --detector_precision <string>
 //   --apply_smoothing <bool>
+//   --inference_engine <string>
+//   --ort_intra_op_threads <int>
+//   --dnn_backends <string,string,...>
+//   --backend_cache_path <string>
+//   --dnn_fusion <bool>
+//   --detector_warmup_runs <int>
+//   --nms_mode <string>
+//   --nms_iou_threshold <float>
+//   --nms_sigma <float>
+//   --motion_gate <bool>
+//   --motion_threshold <float>
+//   --motion_max_age <int>
+//   --tiled_detection <bool>
+//   --tile_size <int>
+//   --tile_overlap <float>
+//   --max_tiles <int>
+//   --tile_motion_threshold <float>
+//   --inference_threads <int>
+//   --capture_cores <int,int-int,...>
+//   --inference_cores <int,int-int,...>
+//   --render_cores <int,int-int,...>
+//   --capture_priority <int>
 //   --camera_speed <float>
 //   --mouse_sensitivity <float>
 //   --camera_zoom <float>
 //   --init_position <float,float,float>
 //   --earth_model_path <string>
 //   --earth_scale <float>
+//   --compressed_textures <bool>
+//   --texture_streaming <bool>
+//   --texture_upload_budget_kb <int>
+//   --keep_mesh_data <bool>
+//   --batched_submission <bool>
+//   --draw_order <string>
+//   --frustum_culling <bool>
+//   --occlusion_culling <bool>
+//   --occlusion_queries <bool>
 //   --moon_model_path <string>
 //   --moon_orbit_radius <float>
 //   --moon_scale <float>
@@ -142,6 +314,19 @@ struct CLIOptions {
 //   --earth_fragment_shader_path <string>
 //   --bg_vertex_shader_path <string>
 //   --bg_fragment_shader_path <string>
+//   --batch_vertex_shader_path <string>
+//   --occlusion_vertex_shader_path <string>
+//   --occlusion_fragment_shader_path <string>
+//   --headless <bool>
+//   --headless_frames <int>
+//   --headless_output <string>
+//   --trace_enabled <bool>
+//   --trace_path <string>
+//   --latency_report <bool>
+//   --bench_iterations <int>
+//   --bench_warmup <int>
+//   --bench_json_path <string>
+//   --bench_objects <int>
 //   --config_path <string> 
 //   --show_help
 CLIOptions parseCli(int argc, char** argv);
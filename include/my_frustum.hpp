@@ -0,0 +1,47 @@
+#ifndef MY_FRUSTUM_HPP
+#define MY_FRUSTUM_HPP
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The six planes of a view frustum, extracted from projection * view
+// (Gribb/Hartmann) and normalized: dot(plane.xyz, p) + plane.w is the signed
+// distance of world point p, positive inside.
+struct Frustum {
+    glm::vec4 planes[6]; // left, right, bottom, top, near, far
+
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+};
+
+// Sphere (center, radius) placed by `transform`: xyz centre, w radius grown by the largest axis scale
+glm::vec4 transformSphere(const glm::mat4& transform, const glm::vec3& center, float radius);
+// ... with the radius shrunk by the smallest axis scale, for a ball that must stay inside a surface
+glm::vec4 transformInnerSphere(const glm::mat4& transform, const glm::vec3& center, float radius);
+
+// World-space bounding spheres as a structure of arrays, so they can be tested
+// against the frustum four at a time. A sphere is culled when it lies entirely
+// behind any one plane.
+class SphereCuller {
+public:
+    void clear();
+
+    // Add a mesh-space sphere placed by `transform`; the radius grows with its largest axis scale.
+    // Returns the sphere's index.
+    size_t push(const glm::mat4& transform, const glm::vec3& center, float radius);
+
+    // Test every sphere; returns how many were culled
+    size_t cull(const Frustum& frustum);
+
+    bool visible(size_t i) const { return visible_[i] != 0; }
+    size_t size() const { return count_; }
+
+private:
+    size_t count_ = 0;
+    std::vector<float> x_, y_, z_, r_; // padded to a multiple of four in cull()
+    std::vector<uint8_t> visible_;
+};
+
+#endif // MY_FRUSTUM_HPP
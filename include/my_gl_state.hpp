@@ -0,0 +1,47 @@
+#ifndef MY_GL_STATE_HPP
+#define MY_GL_STATE_HPP
+
+#include <glad/glad.h>
+
+#include <utility>
+#include <vector>
+
+// Shadow of the render thread's GL bindings that skips redundant calls; invalidate() after raw GL
+class GLStateCache {
+public:
+    static const unsigned int MAX_TEXTURE_UNITS = 16;
+
+    GLStateCache() { invalidate(); }
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vao);
+    void activeTexture(unsigned int unit);
+    // Bind `texture` to `target` (GL_TEXTURE_2D or GL_TEXTURE_BUFFER) on `unit`, activating it if needed
+    void bindTexture(unsigned int unit, GLenum target, GLuint texture);
+    void enable(GLenum cap);
+    void disable(GLenum cap);
+
+    void deleteTexture(GLuint texture);
+    void deleteVertexArray(GLuint vao);
+
+    // Forget everything; the next call of each kind is issued
+    void invalidate();
+
+private:
+    static const GLuint UNKNOWN = 0xFFFFFFFFu;
+
+    GLuint program_ = UNKNOWN;
+    GLuint vao_ = UNKNOWN;
+    unsigned int activeUnit_ = UNKNOWN;
+    GLuint textures2D_[MAX_TEXTURE_UNITS];
+    GLuint texturesBuffer_[MAX_TEXTURE_UNITS];
+    std::vector<std::pair<GLenum, bool>> caps_; // only caps set through the cache are known
+
+    bool textureSlot_(unsigned int unit, GLenum target, GLuint*& slot);
+    void setCap_(GLenum cap, bool on);
+};
+
+// The render thread's state cache
+GLStateCache& glState();
+
+#endif // MY_GL_STATE_HPP
@@ -1,9 +1,17 @@
 #ifndef MY_HANDS_HPP
 #define MY_HANDS_HPP
 
+#include <my_nms.hpp>
+#include <my_motion.hpp>
+#include <my_backend.hpp>
+#include <my_ort.hpp>
+#include <my_tiles.hpp>
+
 #include <opencv2/imgproc.hpp>
 #include <opencv2/core.hpp>
 #include <opencv2/dnn.hpp>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <string>
 #include <cmath>
@@ -16,34 +24,207 @@ struct HandResult {
     float score = 0.0f;    // detection confidence
 };
 
+// Letterbox geometry mapping detector input pixels back to the frame
+struct Letterbox {
+    float ratio = 1.0f;  // frame -> input scale
+    int padX = 0;        // input pixels of padding left/top
+    int padY = 0;
+};
+
+// Per-stage timings of the most recent infer() call (ms)
+struct HandTimings {
+    double preprocessMs = 0.0;  // letterbox + blobFromImage
+    double forwardMs = 0.0;     // detNet_.forward()
+    double postprocessMs = 0.0; // decode + NMS
+    double motionMs = 0.0;      // motion gate check
+    bool skipped = false;       // detector skipped, previous hands reused
+};
+
 class HandTracker {
 public:
+    ~HandTracker();
+
     // Load YOLO detector (ONNX)
     bool load(const std::string& detectorOnnxPath,
               int detectorInput,
               bool applySmoothing,
               std::string& err);
 
-    // Backend/target control
+    // Backend/target control (applies to every preloaded input size)
     void setBackendTarget(int backend, int target);
 
+    // Runtime for the network; set before load(). intraOpThreads applies to ONNX Runtime
+    void setEngine(InferenceEngine engine, int intraOpThreads) {
+        engine_ = engine;
+        ortThreads_ = intraOpThreads;
+    }
+
+    // Layer fusion (off by default; set before load() or re-applied to a loaded net)
+    void setFusion(bool enabled);
+
+    // Time a few forwards on each available candidate and keep the fastest whose
+    // output matches OpenCV's CPU FP32 result. The choice is cached in cachePath
+    // (empty = no cache) keyed by model hash and machine.
+    bool selectBackend(const std::vector<BackendCandidate>& candidates,
+                       const std::string& cachePath,
+                       std::string& err);
+
+    // Name of the backend chosen by selectBackend()
+    const std::string& backendName() const { return backendName_; }
+
+    // Adaptive input resolution: preload one net per size (call after selectBackend
+    // so each is warmed up on the chosen backend). The detector then steps down a
+    // size while its time exceeds budgetMs, and back up when there is headroom or
+    // detection confidence drops. Sizes the model cannot run at are skipped.
+    bool setAdaptiveSizes(const std::vector<int>& sizes, double budgetMs, std::string& err);
+
+    // Current detector input size
+    int inputSize() const { return detSize_; }
+
+    // Suppression of overlapping detections (hard by default); soft-NMS rescored
+    // detections must still clear the detection confidence threshold
+    void setNmsParams(const NmsParams& params) {
+        nmsParams_ = params;
+        nmsParams_.scoreThreshold = confidenceThreshold_;
+    }
+
+    // Skip the detector while the scene is static (see MotionGate)
+    void setMotionGate(bool enabled, float threshold, unsigned int maxAge) {
+        motionGate_.configure(enabled, threshold, maxAge);
+    }
+    const MotionGate& motionGate() const { return motionGate_; }
+
+    // Tiled detection for high-resolution frames: besides the whole (letterboxed)
+    // frame, run the detector at full resolution on the few overlapping tiles that
+    // hold a track or motion (see TilePlanner), then merge everything with one NMS.
+    // Compute stays bounded at 1 + maxTiles inputs per frame, batched when possible.
+    void setTiling(const TilingParams& params) { tilePlanner_.configure(params); }
+    const TilePlanner& tilePlanner() const { return tilePlanner_; }
+
+    // Detector preprocessing: letterbox a BGR frame to a square NCHW float blob
+    // (also used to produce INT8 calibration data)
+    static Letterbox makeInputBlob(const cv::Mat& frameBGR, int inputSize, cv::Mat& blob);
+    static Letterbox letterboxFrame(const cv::Mat& frameBGR, int inputSize, cv::Mat& letterboxed);
+
     // Run detection on a BGR frame; returns hands
     std::vector<HandResult> infer(const cv::Mat& frameBGR);
 
+    // Run detection on N frames (several cameras, or tiles of one frame) in a single
+    // forward pass with batch N; returns raw per-frame hands (no smoothing or motion
+    // gating, which track one stream). Models or engines without a dynamic batch
+    // dimension fall back to one forward per frame.
+    std::vector<std::vector<HandResult>> inferBatch(const std::vector<cv::Mat>& framesBGR);
+
+    // Stage breakdown of the last infer() / inferBatch() call
+    const HandTimings& lastTimings() const { return timings_; }
+
+    // Run `runs` forwards on a dummy frame on a background thread, so layer
+    // allocation and backend initialisation happen while the caller loads
+    // everything else. Call once the backend and input size are final: changing
+    // either rebuilds the net. Every other call waits for the warm-up to finish.
+    // The warm-up thread is pinned to `cores` (empty = unpinned) before its first forward.
+    void startWarmup(unsigned int runs, const std::vector<int>& cores = {});
+
+    // Warm-up wall time and its first (cold) forward; read once infer() has run
+    double warmupMs() const { return warmupMs_; }
+    double coldForwardMs() const { return coldForwardMs_; }
+
+    // Time of the first real infer(), including any wait for the warm-up; -1 before it
+    double firstInferenceMs() const { return firstInferenceMs_; }
+
 private:
     // DNN
     cv::dnn::Net detNet_;
+    InferenceEngine engine_ = ENGINE_OPENCV_DNN;
+    int ortThreads_ = 0;
+    std::unique_ptr<OrtDetector> ortNet_; // set when running on ONNX Runtime
+    uint64_t ortFailures_ = 0;            // consecutive failed runs, for rate-limited logging
+    cv::Mat blob_;                        // OpenCV DNN input, reused across frames
+
+    std::string modelPath_;
+    std::string backendName_{"default"};
+    bool fusion_ = false;
+
+    int backend_ = cv::dnn::DNN_BACKEND_DEFAULT;
+    int target_ = cv::dnn::DNN_TARGET_CPU;
 
     // Input sizes
     int detSize_ = 640;   // YOLO input (square)
 
+    // Preloaded nets for the other input sizes; switching swaps one with the active net
+    struct DetectorNet {
+        int inputSize = 0;
+        cv::dnn::Net dnn;
+        std::unique_ptr<OrtDetector> ort;
+        cv::Mat blob;
+    };
+    std::vector<DetectorNet> sizeNets_;
+    double budgetMs_ = 0.0;          // 0 = fixed input size
+    double detectorEmaMs_ = 0.0;     // smoothed detector time at the current size
+    float confidenceEma_ = 1.0f;     // smoothed top detection score
+    unsigned int framesSinceSwitch_ = 0;
+
     // Smoothing configuration
     bool applySmoothing_ = true; // Whether to apply smoothing
     float smoothingAlpha_ = 0.3f; // Smoothing factor for EMA
     std::vector<cv::Rect> smoothedRois_; // Smoothed ROIs
 
+    // Motion gating
+    MotionGate motionGate_;
+    std::vector<HandResult> lastHands_;  // returned while the detector is skipped
+
+    // Tiling
+    TilePlanner tilePlanner_;
+    std::vector<cv::Rect> trackRois_;
+    std::vector<cv::Rect> tiles_;
+    std::vector<cv::Rect> tileRegions_;  // frame region behind each tiled input
+
+    // Post-processing
+    float confidenceThreshold_ = 0.8f;
+    NmsParams nmsParams_;
+    BoxSoA candidates_;
+    BoxNms nms_;
+    std::vector<int> keepIndices_;
+    std::vector<float> keptScores_;
+
+    // Batching
+    bool batchSupported_ = true;
+    std::vector<cv::Mat> batchInputs_;
+    std::vector<Letterbox> batchLetterboxes_;
+    cv::Mat batchBlob_;
+
+    // Profiling
+    HandTimings timings_;
+
+    // Warm-up (owns the nets while running)
+    std::thread warmupThread_;
+    double warmupMs_ = 0.0;
+    double coldForwardMs_ = 0.0;
+    double firstInferenceMs_ = -1.0;
+
     // Pipeline steps
+    bool loaded_() const { return ortNet_ || !detNet_.empty(); }
+    bool runOrt_(cv::Mat& output);
+    double waitForWarmup_();
+    void warmup_(unsigned int runs, std::vector<int> cores);
     std::vector<HandResult> runPalmDetector_(const cv::Mat& frameBGR);
+    std::vector<HandResult> runTiled_(const cv::Mat& frameBGR);
+    std::vector<HandResult> decodeDetections_(const cv::Mat& output, int batchIndex,
+                                              const Letterbox& letterbox, cv::Size frameSize);
+    // Append the detections of one input (covering `region` of a frame of frameSize) to candidates_
+    void collectCandidates_(const cv::Mat& output, int batchIndex, const Letterbox& letterbox,
+                            const cv::Rect& region, cv::Size frameSize);
+    std::vector<HandResult> suppressCandidates_();
+    void adaptInputSize_(const std::vector<HandResult>& detections);
+    void switchInputSize_(size_t netIndex, const char* reason);
 };
 
+struct CLIOptions;
+
+// Apply every detector option (engine, threads, model, backend selection, adaptive sizes,
+// NMS, motion gate, tiling) and start the warm-up, as the app runs it. The calling thread
+// does the setup pinned to inference_cores, so OpenCV's worker pool is created there, and
+// gets its own mask back afterwards. False (with err) only if the model fails to load.
+bool configureHandTracker(HandTracker& tracker, const CLIOptions& options, std::string& err);
+
 #endif // MY_HANDS_HPP
\ No newline at end of file
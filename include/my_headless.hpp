@@ -0,0 +1,47 @@
+#ifndef MY_HEADLESS_HPP
+#define MY_HEADLESS_HPP
+
+#include <glad/glad.h>
+#ifndef EGL_NO_X11
+#define EGL_NO_X11 // Keep Xlib macros out of OpenCV/GLM code
+#endif
+#include <EGL/egl.h>
+#include <opencv2/core.hpp>
+#include <string>
+
+// Offscreen OpenGL 3.3 core context for machines without a display.
+// Uses an EGL pbuffer on the default display, falling back to Mesa's
+// surfaceless platform (llvmpipe when no GPU is present). All rendering
+// goes into an FBO of the requested size.
+class HeadlessContext {
+public:
+    HeadlessContext(int width, int height);
+    ~HeadlessContext();
+
+    // Create display/context, load GL with GLAD and create the FBO
+    bool initialize(std::string& errMsg);
+
+    // Bind the offscreen framebuffer and set the viewport to its size
+    void bindFramebuffer();
+
+    // Block until all submitted GL work is done (stands in for a buffer swap)
+    void finish();
+
+    // Read back the colour attachment as a top-down BGR image
+    bool readPixels(cv::Mat& frameBGR);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+private:
+    int width_, height_;
+    EGLDisplay display_;
+    EGLSurface surface_;
+    EGLContext context_;
+    GLuint fbo_, colorRb_, depthRb_;
+
+    bool createDisplay_(std::string& errMsg);
+    bool createFramebuffer_(std::string& errMsg);
+};
+
+#endif // MY_HEADLESS_HPP
@@ -0,0 +1,36 @@
+#ifndef MY_KTX_HPP
+#define MY_KTX_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Vulkan format codes used in the KTX2 header for the formats we read and write
+enum KtxVkFormat : uint32_t {
+    VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131,
+    VK_FORMAT_BC1_RGBA_UNORM_BLOCK = 133,
+    VK_FORMAT_BC3_UNORM_BLOCK = 137,
+    VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK = 147,
+    VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK = 151
+};
+
+// A 2D block-compressed texture with its mip chain, level 0 (largest) first
+struct KtxTexture {
+    uint32_t vkFormat = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<std::vector<uint8_t>> levels;
+
+    size_t byteSize() const {
+        size_t total = 0;
+        for (const auto& level : levels) total += level.size();
+        return total;
+    }
+};
+
+// KTX 2.0 subset: one 2D image (no layers, faces or supercompression) of a
+// 4x4 block format, with a basic data format descriptor and a KTXwriter entry
+bool writeKtx2(const std::string& path, const KtxTexture& texture, const std::string& writer, std::string& err);
+bool readKtx2(const std::string& bytes, KtxTexture& texture, std::string& err);
+
+#endif // MY_KTX_HPP
@@ -0,0 +1,53 @@
+#ifndef MY_LATENCY_HPP
+#define MY_LATENCY_HPP
+
+#include <my_timing.hpp>
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <iostream>
+
+// Steady clock (CLOCK_MONOTONIC on Linux) in nanoseconds; the same clock V4L2
+// uses for driver buffer timestamps
+inline int64_t monotonicNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        SteadyClock::now().time_since_epoch()).count();
+}
+
+// Timestamps of one frame's trip from sensor to screen (ns, monotonic clock)
+struct FrameStamps {
+    uint64_t frameId = 0;
+    int64_t captureNs = 0;        // V4L2 driver timestamp (or grab time)
+    int64_t detectNs = 0;         // newest detections available at draw time completed
+    int64_t detectCaptureNs = 0;  // capture time of the frame those detections came from
+    int64_t drawNs = 0;           // scene draw that consumed them submitted
+    int64_t presentNs = 0;        // after buffer swap
+};
+
+// Distribution of per-frame pipeline latencies
+class LatencyTracker {
+public:
+    void record(const FrameStamps& stamps);
+    // One finished inference, including those the renderer skipped
+    void recordInference(int64_t captureNs, int64_t detectNs);
+
+    size_t count() const { return captureToPresent_.count(); }
+
+    void printSummary(std::ostream& os = std::cout) const;
+    void writeJson(std::ostream& os) const;
+
+private:
+    TimingStats captureToDetect_;    // inference latency of the detections used
+    TimingStats inferenceLatency_;   // capture->detect of every inference
+    TimingStats captureToDraw_;
+    TimingStats captureToPresent_;
+    TimingStats detectionStaleness_; // present - capture of the detections shown
+};
+
+// Synthetic frames carry their frame id and capture time as a strip of black
+// and white blocks along the top edge, so a rendered frame read back from the
+// framebuffer can be matched to its capture time without a camera loop.
+void encodeFrameStamp(cv::Mat& frameBGR, uint16_t frameId, int64_t captureNs);
+bool decodeFrameStamp(const cv::Mat& frameBGR, uint16_t& frameId, int64_t& captureNs);
+
+#endif // MY_LATENCY_HPP
@@ -0,0 +1,9 @@
+#ifndef MY_MEMORY_HPP
+#define MY_MEMORY_HPP
+
+#include <cstddef>
+
+// Current resident set size of the process (Linux /proc/self/statm); 0 if unavailable
+size_t residentSetBytes();
+
+#endif // MY_MEMORY_HPP
@@ -7,8 +7,13 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <my_shader.hpp>
+#include <my_render_stats.hpp>
+#include <my_gl_state.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <utility>
 #include <vector>
 
 struct Vertex 
@@ -25,86 +30,145 @@ struct Texture
     std::string path;
 };
 
+// One mesh of a Model. Its vertices and indices live in the model's shared
+// vertex and index buffers, at baseVertex() and firstIndex(); the model binds
+// its VAO once and each mesh only binds its textures and draws its range.
 class Mesh
 {
 public:
     std::vector<Vertex> vertices_;
-    std::vector<unsigned int> indices_;
+    std::vector<unsigned int> indices_; // relative to this mesh's first vertex
     std::vector<Texture> textures_;
     std::string meshName_;
 
-    // Init the mesh
-    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, const std::vector<Texture>& textures, const std::string meshName) 
-        : vertices_(vertices), indices_(indices), textures_(textures), meshName_(meshName) {
-        setupMesh();
+    // Init the mesh (pass the vectors with std::move: they are taken over, not copied)
+    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, std::string meshName)
+        : vertices_(std::move(vertices)), indices_(std::move(indices)), textures_(std::move(textures)),
+          meshName_(std::move(meshName)) {
+        computeBounds();
     }
 
-    // Draw the mesh with identity per-mesh transform
-    void draw(Shader& shader) {
-        // Default mesh transform = identity
-        shader.setMat4("meshModel", glm::mat4(1.0f));
-        // If multiple textures for this mesh, loop through
-        for (unsigned int i = 0; i < static_cast<unsigned int>(textures_.size()); i++) {
-            glActiveTexture(GL_TEXTURE0 + i);
-            std::string textureName = textures_[i].type;
-            shader.setInt(textureName.c_str(), i);
-            glBindTexture(GL_TEXTURE_2D, textures_[i].id);
-        }
+    // Movable, not copyable: a copy would duplicate the vertex data
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+    Mesh(Mesh&&) noexcept = default;
+    Mesh& operator=(Mesh&&) noexcept = default;
+
+    // Drop the CPU copies once they are in GL buffers; counts and bounds stay valid
+    void releaseCpuData() {
+        std::vector<Vertex>().swap(vertices_);
+        std::vector<unsigned int>().swap(indices_);
+    }
+
+    size_t vertexCount() const { return vertexCount_; }
+    size_t indexCount() const { return indexCount_; }
+    // Bytes held in RAM by vertices_/indices_ (0 after releaseCpuData)
+    size_t cpuBytes() const {
+        return vertices_.capacity() * sizeof(Vertex) + indices_.capacity() * sizeof(unsigned int);
+    }
+    size_t gpuBytes() const {
+        return vertexCount_ * sizeof(Vertex) + indexCount_ * sizeof(unsigned int);
+    }
+
+    // Axis-aligned bounds in mesh space
+    const glm::vec3& boundsMin() const { return boundsMin_; }
+    const glm::vec3& boundsMax() const { return boundsMax_; }
+    glm::vec3 boundsCenter() const { return 0.5f * (boundsMin_ + boundsMax_); }
+    // Bounding sphere around boundsCenter(), mesh space
+    float boundsRadius() const { return boundsRadius_; }
+    // Distance from boundsCenter() to the nearest triangle: the largest ball there crossing no face
+    float boundsInnerRadius() const { return boundsInnerRadius_; }
+
+    // Sort key for the mesh's texture set: meshes from one material share their first (diffuse) texture
+    unsigned int textureSetKey() const { return textures_.empty() ? 0 : textures_[0].id; }
+
+    // Placement in the owning model's buffers (set by Model when it packs them)
+    void setBufferRange(GLint baseVertex, size_t firstIndex) {
+        baseVertex_ = baseVertex;
+        firstIndex_ = firstIndex;
+    }
+    GLint baseVertex() const { return baseVertex_; }
+    size_t firstIndex() const { return firstIndex_; }
 
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices_.size()), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
-        glActiveTexture(GL_TEXTURE0);
+    // Draw the mesh with identity per-mesh transform; the model's VAO must be bound
+    void draw(Shader& shader) {
+        draw(shader, glm::mat4(1.0f));
     }
 
-    // Draw the mesh with a supplied per-mesh transform
+    // Draw the mesh with a supplied per-mesh transform; the model's VAO must be bound
     void draw(Shader& shader, const glm::mat4& meshModel) {
         shader.setMat4("meshModel", meshModel);
         // If multiple textures for this mesh, loop through
         for (unsigned int i = 0; i < static_cast<unsigned int>(textures_.size()); i++) {
-            glActiveTexture(GL_TEXTURE0 + i);
-            std::string textureName = textures_[i].type;
-            shader.setInt(textureName.c_str(), i);
-            glBindTexture(GL_TEXTURE_2D, textures_[i].id);
+            shader.setInt(textures_[i].type, i);
+            glState().bindTexture(i, GL_TEXTURE_2D, textures_[i].id);
         }
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices_.size()), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
-        glActiveTexture(GL_TEXTURE0);
+        glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(indexCount_), GL_UNSIGNED_INT,
+                                 reinterpret_cast<const void*>(firstIndex_ * sizeof(unsigned int)), baseVertex_);
+        ++frameRenderCounters().drawCalls;
     }
 
 private:
-    unsigned int VAO, VBO, EBO;
-
-    // Setup
-    void setupMesh() {
-        // Create buffers/arrays
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
-
-        // Bind VAO
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices_.size() * sizeof(Vertex), &vertices_[0], GL_STATIC_DRAW);
-
-        // EBO
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices_.size() * sizeof(unsigned int), &indices_[0], GL_STATIC_DRAW);
-
-        // Vertex positions
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-
-        // Vertex normals
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-
-        // Vertex texture coords
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
+    size_t vertexCount_ = 0;
+    size_t indexCount_ = 0;
+    glm::vec3 boundsMin_{0.0f};
+    glm::vec3 boundsMax_{0.0f};
+    float boundsRadius_ = 0.0f;
+    float boundsInnerRadius_ = 0.0f;
+    GLint baseVertex_ = 0;
+    size_t firstIndex_ = 0;
+
+    void computeBounds() {
+        vertexCount_ = vertices_.size();
+        indexCount_ = indices_.size();
+        if (vertices_.empty()) return;
+        boundsMin_ = boundsMax_ = vertices_[0].position;
+        for (const Vertex& v : vertices_) {
+            boundsMin_ = glm::min(boundsMin_, v.position);
+            boundsMax_ = glm::max(boundsMax_, v.position);
+        }
+        // Tighter than the box's half-diagonal: farthest vertex from the box centre
+        const glm::vec3 center = boundsCenter();
+        float radius2 = 0.0f;
+        for (const Vertex& v : vertices_) {
+            radius2 = std::max(radius2, glm::dot(v.position - center, v.position - center));
+        }
+        boundsRadius_ = std::sqrt(radius2);
+
+        // Faces can pass closer to the centre than any vertex, so measure to the triangles themselves
+        float inner2 = indices_.size() >= 3 ? radius2 : 0.0f;
+        for (size_t i = 0; i + 2 < indices_.size(); i += 3) {
+            const glm::vec3& a = vertices_[indices_[i]].position;
+            const glm::vec3& b = vertices_[indices_[i + 1]].position;
+            const glm::vec3& c = vertices_[indices_[i + 2]].position;
+            const glm::vec3 normal = glm::cross(b - a, c - a);
+            if (glm::dot(normal, normal) == 0.0f) continue; // no area, nothing to hide behind
+            const glm::vec3 d = closestPointOnTriangle(center, a, b, c) - center;
+            inner2 = std::min(inner2, glm::dot(d, d));
+        }
+        boundsInnerRadius_ = std::sqrt(inner2);
+    }
 
-        glBindVertexArray(0);
+    // Point of triangle abc nearest to p (Ericson, Real-Time Collision Detection 5.1.5)
+    static glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b,
+                                            const glm::vec3& c) {
+        const glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+        const float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) return a;
+        const glm::vec3 bp = p - b;
+        const float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) return b;
+        const float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+        const glm::vec3 cp = p - c;
+        const float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) return c;
+        const float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+        const float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        const float denom = 1.0f / (va + vb + vc);
+        return a + ab * (vb * denom) + ac * (vc * denom);
     }
 };
 #endif // MY_MESH_HPP
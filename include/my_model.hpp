@@ -5,14 +5,18 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-#include <stb_image.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
 #include <my_mesh.hpp>
 #include <my_shader.hpp>
+#include <my_trace.hpp>
+#include <my_texture_cache.hpp>
+#include <my_memory.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -24,22 +28,118 @@
 class Model
 {
 public:
-    // Constructor (expects a filepath to a 3D model)
-    Model(std::string const& objPath, const std::string& modelName) {
+    // Constructor (expects a filepath to a 3D model). Unless keepCpuData, each
+    // mesh's vertex/index vectors are freed once they are in GL buffers.
+    Model(std::string const& objPath, const std::string& modelName, bool keepCpuData = true) {
         modelName_ = modelName;
+        const size_t rssBefore = residentSetBytes();
         loadModel(objPath);
-        printModelDetails();
+        setupBuffers();
+        const size_t rssLoaded = residentSetBytes();
+        for (const auto& mesh : meshes_) {
+            loadedCpuBytes_ += mesh.cpuBytes();
+        }
+        if (!keepCpuData) {
+            for (auto& mesh : meshes_) {
+                mesh.releaseCpuData();
+            }
+        }
+        printModelDetails(rssBefore, rssLoaded, residentSetBytes());
+    }
+
+    // Textures are shared through TextureCache; hand back this model's references
+    ~Model() {
+        for (unsigned int id : textureRefs_) {
+            TextureCache::instance().release(id);
+        }
+        if (VAO_ != 0) {
+            glState().deleteVertexArray(VAO_);
+            glDeleteBuffers(1, &VBO_);
+            glDeleteBuffers(1, &EBO_);
+        }
+    }
+
+    Model(const Model&) = delete;
+    Model& operator=(const Model&) = delete;
+
+    // Mesh data still held in RAM, and what the meshes occupy in GL buffers
+    size_t cpuBytes() const {
+        size_t total = 0;
+        for (const auto& mesh : meshes_) total += mesh.cpuBytes();
+        return total;
+    }
+    size_t gpuBytes() const {
+        size_t total = 0;
+        for (const auto& mesh : meshes_) total += mesh.gpuBytes();
+        return total;
+    }
+
+    // Axis-aligned bounds of all meshes, in model space (before per-mesh transforms)
+    glm::vec3 boundsMin() const {
+        glm::vec3 lo = meshes_.empty() ? glm::vec3(0.0f) : meshes_[0].boundsMin();
+        for (const auto& mesh : meshes_) lo = glm::min(lo, mesh.boundsMin());
+        return lo;
+    }
+    glm::vec3 boundsMax() const {
+        glm::vec3 hi = meshes_.empty() ? glm::vec3(0.0f) : meshes_[0].boundsMax();
+        for (const auto& mesh : meshes_) hi = glm::max(hi, mesh.boundsMax());
+        return hi;
+    }
+
+    // Bounding sphere enclosing every mesh's sphere, model space
+    glm::vec3 boundsCenter() const { return 0.5f * (boundsMin() + boundsMax()); }
+    float boundsRadius() const {
+        const glm::vec3 center = boundsCenter();
+        float radius = 0.0f;
+        for (const auto& mesh : meshes_) {
+            radius = std::max(radius, glm::length(mesh.boundsCenter() - center) + mesh.boundsRadius());
+        }
+        return radius;
+    }
+    // Ball around boundsCenter() crossing none of some mesh's triangles (inside it if that mesh is closed)
+    float innerRadius() const {
+        const glm::vec3 center = boundsCenter();
+        float radius = 0.0f;
+        for (const auto& mesh : meshes_) {
+            radius = std::max(radius, mesh.boundsInnerRadius() - glm::length(mesh.boundsCenter() - center));
+        }
+        return radius;
+    }
+
+    // Packed geometry, for SceneBatch to copy into its shared buffers
+    const std::vector<Mesh>& meshes() const { return meshes_; }
+    unsigned int vertexBuffer() const { return VBO_; }
+    unsigned int indexBuffer() const { return EBO_; }
+    size_t vertexCount() const {
+        size_t total = 0;
+        for (const auto& mesh : meshes_) total += mesh.vertexCount();
+        return total;
+    }
+    size_t indexCount() const {
+        size_t total = 0;
+        for (const auto& mesh : meshes_) total += mesh.indexCount();
+        return total;
     }
 
     // Draw the model (all its meshes)
     void draw(Shader& shader) {
+        MY_TRACE_SCOPE("Model::draw");
+        bindBuffers();
         for (unsigned int i = 0; i < static_cast<unsigned int>(meshes_.size()); i++) {
             meshes_[i].draw(shader);
         }
     }
 
+    // Draw a single mesh (render queue order); the VAO bind is skipped while it stays bound
+    void drawMesh(Shader& shader, size_t index, const glm::mat4& meshModel) {
+        bindBuffers();
+        meshes_[index].draw(shader, meshModel);
+    }
+
     // Draw with a per-mesh transform provider (returns a mesh-space transform for a mesh name)
     void drawWithTransforms(Shader& shader, const std::function<glm::mat4(const std::string&)>& getTransform) {
+        MY_TRACE_SCOPE("Model::drawWithTransforms");
+        bindBuffers();
         for (unsigned int i = 0; i < static_cast<unsigned int>(meshes_.size()); i++) {
             const std::string& name = meshes_[i].meshName_;
             glm::mat4 mm = glm::mat4(1.0f);
@@ -53,7 +153,60 @@ public:
 private:
     std::string modelName_;
     std::vector<Mesh> meshes_;
-    std::vector<Texture> loadedTextures_;
+    std::vector<unsigned int> textureRefs_; // acquired from TextureCache
+    size_t loadedCpuBytes_ = 0;             // mesh data in RAM right after loading
+    unsigned int VAO_ = 0, VBO_ = 0, EBO_ = 0; // every mesh's vertices and indices, back to back
+
+    // One VAO bind for the whole model; the element buffer binding is part of the VAO.
+    // It stays bound after the draw: anything that binds an element buffer binds its own VAO first.
+    void bindBuffers() {
+        glState().bindVertexArray(VAO_);
+    }
+
+    // Pack all meshes into one vertex buffer and one index buffer. Indices stay
+    // relative to their mesh; glDrawElementsBaseVertex adds the mesh's offset.
+    void setupBuffers() {
+        size_t totalVertices = 0, totalIndices = 0;
+        for (const auto& mesh : meshes_) {
+            totalVertices += mesh.vertices_.size();
+            totalIndices += mesh.indices_.size();
+        }
+
+        glGenVertexArrays(1, &VAO_);
+        glGenBuffers(1, &VBO_);
+        glGenBuffers(1, &EBO_);
+        glState().bindVertexArray(VAO_);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+        glBufferData(GL_ARRAY_BUFFER, totalVertices * sizeof(Vertex), nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, totalIndices * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+
+        // Copied mesh by mesh, so the packed data never exists as a second CPU copy
+        size_t baseVertex = 0, firstIndex = 0;
+        for (auto& mesh : meshes_) {
+            glBufferSubData(GL_ARRAY_BUFFER, baseVertex * sizeof(Vertex),
+                            mesh.vertices_.size() * sizeof(Vertex), mesh.vertices_.data());
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, firstIndex * sizeof(unsigned int),
+                            mesh.indices_.size() * sizeof(unsigned int), mesh.indices_.data());
+            mesh.setBufferRange(static_cast<GLint>(baseVertex), firstIndex);
+            baseVertex += mesh.vertices_.size();
+            firstIndex += mesh.indices_.size();
+        }
+
+        // Vertex positions
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+
+        // Vertex normals
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+
+        // Vertex texture coords
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
+
+        glState().bindVertexArray(0);
+    }
 
     // Load a 3D model specified by path
     void loadModel(std::string const& path) {
@@ -89,6 +242,8 @@ private:
         std::vector<Vertex> vertices;
         std::vector<unsigned int> indices;
         std::vector<Texture> textures;
+        vertices.reserve(mesh->mNumVertices);
+        indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
 
         // Loop through mesh's vertices
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
@@ -147,87 +302,48 @@ private:
         std::vector<Texture> bumpMaps = loadMaterialTextures(material, aiTextureType_HEIGHT, "bumpMap");
         textures.insert(textures.end(), bumpMaps.begin(), bumpMaps.end());
 
-        return Mesh(vertices, indices, textures, std::string(mesh->mName.C_Str()));
+        return Mesh(std::move(vertices), std::move(indices), std::move(textures), std::string(mesh->mName.C_Str()));
     }
 
-    // Load materials
+    // Load materials (shared with other models through TextureCache)
     std::vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName) {
         std::vector<Texture> textures;
         for (unsigned int i = 0; i < mat->GetTextureCount(type); i++) {
             aiString str;
             mat->GetTexture(type, i, &str);
 
-            // Check if texture already loaded and if so, continue
-            bool skip = false;
-            for (int j = 0; j < static_cast<int>(loadedTextures_.size()); j++) {
-                if (std::strcmp(loadedTextures_[j].path.data(), str.C_Str()) == 0) {
-                    textures.push_back(loadedTextures_[j]);
-                    skip = true; 
-                    break;
-                }
-            }
-            if (!skip) {
-                Texture texture;
-                texture.id = loadTexture(str.C_Str());
-                texture.type = typeName;
-                texture.path = str.C_Str();
-                textures.push_back(texture);
-                loadedTextures_.push_back(texture);
+            Texture texture;
+            texture.id = TextureCache::instance().acquire(str.C_Str(),
+                typeName == "normalMap" ? PLACEHOLDER_FLAT_NORMAL : PLACEHOLDER_GREY);
+            texture.type = typeName;
+            texture.path = str.C_Str();
+            if (texture.id != 0) {
+                textureRefs_.push_back(texture.id);
             }
+            textures.push_back(texture);
         }
         return textures;
     }
 
-    // Load texture
-    unsigned int loadTexture(const char* texturePath) {
-        unsigned int textureID;
-        glGenTextures(1, &textureID);
-
-        stbi_set_flip_vertically_on_load(false);
-        int width, height, numChannels;
-        unsigned char* data = stbi_load(texturePath, &width, &height, &numChannels, 0);
-        if (data) {
-            GLenum format = GL_RGB;
-            if (numChannels == 1) {
-                format = GL_RED;
-            } else if (numChannels == 3) {
-                format = GL_RGB;
-            } else if (numChannels == 4) {
-                format = GL_RGBA;
-            }
-
-            glBindTexture(GL_TEXTURE_2D, textureID);
-            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-            // Use MIPMAPs for better texture rendering
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glGenerateMipmap(GL_TEXTURE_2D);
-        } else {
-            std::cout << "Texture failed to load at path: " << texturePath << std::endl;
-        }
-
-        stbi_image_free(data);
-        return textureID;
-    }
-
-    void printModelDetails() {
+    void printModelDetails(size_t rssBefore, size_t rssLoaded, size_t rssNow) {
         unsigned int totalVertices = 0;
         unsigned int totalTriangles = 0;
 
         for (const auto& mesh : meshes_) {
-            totalVertices += static_cast<unsigned int>(mesh.vertices_.size());
-            totalTriangles += static_cast<unsigned int>(mesh.indices_.size()) / 3;
+            totalVertices += static_cast<unsigned int>(mesh.vertexCount());
+            totalTriangles += static_cast<unsigned int>(mesh.indexCount()) / 3;
         }
+        const double MiB = 1024.0 * 1024.0;
 
         std::cout << "****************************\n";
         std::cout << "Successfully Loaded Model: " << modelName_ << "\n";
         std::cout << "Model contains " << meshes_.size() << " mesh(es).\n";
         std::cout << "Total vertices: " << totalVertices << "\n";
         std::cout << "Total triangles: " << totalTriangles << "\n";
+        std::cout << "Mesh data in RAM: " << loadedCpuBytes_ / MiB << " MiB after load, " << cpuBytes() / MiB
+                  << " MiB now (" << gpuBytes() / MiB << " MiB in GL buffers)\n";
+        std::cout << "Process RSS: " << rssBefore / MiB << " MiB before, " << rssLoaded / MiB << " MiB loaded, "
+                  << rssNow / MiB << " MiB now\n";
         std::cout << "****************************\n\n";
     }
 };
@@ -0,0 +1,46 @@
+#ifndef MY_MOTION_HPP
+#define MY_MOTION_HPP
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+
+// Cheap change detector used to skip the hand detector on static frames. Each
+// frame is reduced to a small grey thumbnail and compared (mean absolute
+// difference, SIMD SAD) with the thumbnail of the last frame the detector saw.
+class MotionGate {
+public:
+    // threshold: mean absolute grey-level change (0-255) that counts as motion
+    // maxAge: run the detector at least every maxAge frames, 0 = never forced
+    void configure(bool enabled, float threshold, unsigned int maxAge);
+
+    bool enabled() const { return enabled_; }
+
+    // True if the detector should run on this frame; call once per frame
+    bool shouldRun(const cv::Mat& frameBGR);
+
+    // Mean absolute difference measured by the last shouldRun()
+    float lastEnergy() const { return lastEnergy_; }
+
+    uint64_t framesSeen() const { return framesSeen_; }
+    uint64_t framesSkipped() const { return framesSkipped_; }
+    double skippedFraction() const {
+        return framesSeen_ ? static_cast<double>(framesSkipped_) / framesSeen_ : 0.0;
+    }
+
+private:
+    bool enabled_ = false;
+    float threshold_ = 2.0f;
+    unsigned int maxAge_ = 30;
+
+    cv::Mat thumbnail_;   // current frame, reduced
+    cv::Mat reference_;   // frame the detector last ran on, reduced
+    unsigned int age_ = 0;
+    float lastEnergy_ = 0.0f;
+    uint64_t framesSeen_ = 0;
+    uint64_t framesSkipped_ = 0;
+};
+
+// Mean absolute difference of two equally sized CV_8UC1 images
+float meanAbsDiff(const cv::Mat& a, const cv::Mat& b);
+
+#endif // MY_MOTION_HPP
@@ -0,0 +1,65 @@
+#ifndef MY_NMS_HPP
+#define MY_NMS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Candidate boxes as a structure of arrays (corner form, pixels), so IoU against
+// one kept box can be computed four candidates at a time
+struct BoxSoA {
+    std::vector<float> x1, y1, x2, y2, score;
+
+    size_t size() const { return score.size(); }
+    bool empty() const { return score.empty(); }
+
+    void clear() {
+        x1.clear(); y1.clear(); x2.clear(); y2.clear(); score.clear();
+    }
+
+    void reserve(size_t n) {
+        x1.reserve(n); y1.reserve(n); x2.reserve(n); y2.reserve(n); score.reserve(n);
+    }
+
+    void push(float left, float top, float right, float bottom, float s) {
+        x1.push_back(left); y1.push_back(top); x2.push_back(right); y2.push_back(bottom);
+        score.push_back(s);
+    }
+};
+
+enum NmsMode {
+    NMS_HARD,          // drop boxes overlapping a kept box by more than the IoU threshold
+    NMS_SOFT_LINEAR,   // scale their score by (1 - IoU) instead
+    NMS_SOFT_GAUSSIAN  // scale every overlapping score by exp(-IoU^2 / sigma)
+};
+
+struct NmsParams {
+    NmsMode mode = NMS_HARD;
+    float iouThreshold = 0.3f;
+    float sigma = 0.5f;         // soft gaussian only
+    float scoreThreshold = 0.0f; // soft modes: drop boxes decayed below this
+};
+
+// "hard", "soft_linear" or "soft_gaussian"
+bool parseNmsMode(const std::string& name, NmsMode& mode);
+
+// Non-maximum suppression with reusable scratch buffers; not thread-safe, keep
+// one per detector
+class BoxNms {
+public:
+    // Fills keepIndices (into `boxes`, best first) and keptScores (decayed in soft modes)
+    void run(const BoxSoA& boxes, const NmsParams& params,
+             std::vector<int>& keepIndices, std::vector<float>& keptScores);
+
+private:
+    BoxSoA sorted_;             // candidates in descending score order, padded to 4
+    std::vector<float> area_;
+    std::vector<float> scratchIou_;
+    std::vector<int> order_;
+
+    void sortByScore_(const BoxSoA& boxes);
+    void suppressHard_(size_t kept, size_t count, float iouThreshold);
+    void decaySoft_(size_t kept, size_t count, const NmsParams& params);
+};
+
+#endif // MY_NMS_HPP
@@ -0,0 +1,51 @@
+#ifndef MY_OCCLUSION_HPP
+#define MY_OCCLUSION_HPP
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <my_shader.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// True if the sphere (center, radius) is entirely hidden from `eye` behind the
+// opaque sphere (occluderCenter, occluderRadius). Conservative: it must lie
+// inside the occluder's silhouette cone and no nearer than the silhouette.
+bool sphereHiddenBySphere(const glm::vec3& eye, const glm::vec3& occluderCenter, float occluderRadius,
+                          const glm::vec3& center, float radius);
+
+// Hardware occlusion queries for arbitrary occluders. After a frame's draws,
+// issue() rasterizes each object's bounding box (no colour or depth writes)
+// inside a GL_ANY_SAMPLES_PASSED query. A later frame reads the result once
+// it is available, without stalling, so visibility lags by a frame or two.
+// Objects are visible until their first result arrives. Object ids are the
+// indices into the spheres passed to issue(), and must stay stable between
+// frames.
+class OcclusionQueries {
+public:
+    OcclusionQueries(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
+    ~OcclusionQueries();
+
+    OcclusionQueries(const OcclusionQueries&) = delete;
+    OcclusionQueries& operator=(const OcclusionQueries&) = delete;
+
+    // Latest known visibility of object `id`
+    bool visible(size_t id) const { return id >= visible_.size() || visible_[id] != 0; }
+
+    // Collect finished results, then query every object without one in flight.
+    // `spheres` are world-space bounds (xyz centre, w radius).
+    void issue(const std::vector<glm::vec4>& spheres, const glm::mat4& view, const glm::mat4& projection,
+               const glm::vec3& eye);
+
+private:
+    Shader shader_;
+    GLuint boxVAO_ = 0, boxVBO_ = 0, boxEBO_ = 0;
+    std::vector<GLuint> queries_;
+    std::vector<uint8_t> pending_;
+    std::vector<uint8_t> visible_;
+};
+
+#endif // MY_OCCLUSION_HPP
@@ -0,0 +1,35 @@
+#ifndef MY_ORT_HPP
+#define MY_ORT_HPP
+
+#include <opencv2/core.hpp>
+#include <memory>
+#include <string>
+
+// Hand detector forward pass on ONNX Runtime's CPU execution provider. Input
+// and output tensors are bound once (I/O binding) to buffers owned here, so a
+// frame is preprocessed straight into inputBlob() and run() allocates nothing.
+// Only functional when built with MILL_WITH_ONNXRUNTIME.
+class OrtDetector {
+public:
+    OrtDetector();
+    ~OrtDetector();
+
+    // False when the build has no ONNX Runtime support
+    static bool available();
+
+    // intraOpThreads: 0 = ONNX Runtime default (one per physical core)
+    bool load(const std::string& onnxPath, int inputSize, int intraOpThreads, std::string& err);
+
+    // NCHW float input tensor; fill in place (blobFromImage keeps the buffer when the shape matches)
+    cv::Mat& inputBlob() { return inputBlob_; }
+
+    // Run the bound input; output is a view of the bound output buffer, valid until the next run
+    bool run(cv::Mat& output, std::string& err);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    cv::Mat inputBlob_;
+};
+
+#endif // MY_ORT_HPP
@@ -0,0 +1,87 @@
+#ifndef MY_PIPELINE_HPP
+#define MY_PIPELINE_HPP
+
+#include <my_webcam.hpp>
+#include <my_hands.hpp>
+#include <my_spsc.hpp>
+#include <my_threads.hpp>
+
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// A captured frame on its way to the renderer or the detector
+struct FramePacket {
+    cv::Mat frame;
+    uint64_t frameId = 0;
+    int64_t captureNs = 0;
+};
+
+// Detections for one captured frame
+struct DetectionPacket {
+    std::vector<HandResult> hands;
+    uint64_t frameId = 0;
+    int64_t captureNs = 0;  // capture time of the source frame
+    int64_t detectNs = 0;   // when inference finished
+    cv::Size frameSize;
+};
+
+// Timing of one finished inference, whether or not the renderer used its result
+struct InferenceStamp {
+    uint64_t frameId = 0;
+    int64_t captureNs = 0;
+    int64_t detectNs = 0;
+};
+
+// Runs capture and hand detection on their own threads. The capture thread
+// publishes every frame into two latest-value slots (renderer, detector); the
+// detector publishes results into a third. The render thread polls for the
+// newest of each without ever blocking on the other stages. The detector also
+// queues an InferenceStamp per inference, so latency covers every result.
+class FramePipeline {
+public:
+    FramePipeline(MyWebcam& webcam, HandTracker& tracker, int fps);
+    ~FramePipeline();
+
+    // Affinity/priority applied by each stage thread as it starts; set before start()
+    void setThreadConfig(const StageThreadConfig& config) { threadConfig_ = config; }
+
+    void start();
+    void stop();
+
+    // Render thread: switch to the newest frame/detections; false if none newer
+    bool pollFrame();
+    bool pollDetections();
+
+    // Valid until the next poll of the same kind
+    const FramePacket& frame() const { return renderFrames_.readBuffer(); }
+    const DetectionPacket& detections() const { return detections_.readBuffer(); }
+
+    // Render thread: oldest queued inference timing; false if none
+    bool popInferenceStamp(InferenceStamp& stamp) { return inferenceStamps_.tryPop(stamp); }
+    // Stamps lost because the render thread did not drain the queue in time
+    uint64_t droppedInferenceStamps() const { return droppedStamps_.load(std::memory_order_relaxed); }
+
+private:
+    MyWebcam& webcam_;
+    HandTracker& tracker_;
+    int fps_;
+    StageThreadConfig threadConfig_;
+
+    LatestSlot<FramePacket> renderFrames_;
+    LatestSlot<FramePacket> inferenceFrames_;
+    LatestSlot<DetectionPacket> detections_;
+    SpscQueue<InferenceStamp, 256> inferenceStamps_;
+    std::atomic<uint64_t> droppedStamps_{0};
+
+    std::atomic<bool> running_;
+    std::thread captureThread_;
+    std::thread inferenceThread_;
+
+    void captureLoop_();
+    void inferenceLoop_();
+};
+
+#endif // MY_PIPELINE_HPP
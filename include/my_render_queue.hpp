@@ -0,0 +1,45 @@
+#ifndef MY_RENDER_QUEUE_HPP
+#define MY_RENDER_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Depth order of draws within a pass and material
+enum DrawOrder {
+    DRAW_ORDER_NONE,          // submission order (draws are still grouped by pass and material)
+    DRAW_ORDER_FRONT_TO_BACK, // nearest first, so early-Z rejects hidden fragments before shading
+    DRAW_ORDER_BACK_TO_FRONT  // farthest first (blending; worst case for opaque overdraw)
+};
+
+// "none", "front_to_back" or "back_to_front"
+bool parseDrawOrder(const std::string& name, DrawOrder& order);
+
+// Per-frame draws radix-sorted by key: pass (4) | program (12) | texture set (16) | depth (32)
+class RenderQueue {
+public:
+    enum Pass { PASS_BACKGROUND, PASS_OPAQUE, PASS_TRANSPARENT };
+
+    static uint64_t makeKey(unsigned int pass, unsigned int program, unsigned int textureSet, uint32_t depth) {
+        return (static_cast<uint64_t>(pass & 0xF) << 60) | (static_cast<uint64_t>(program & 0xFFF) << 48)
+             | (static_cast<uint64_t>(textureSet & 0xFFFF) << 32) | depth;
+    }
+
+    // Depth key for a view-space distance: its float bits, which order like the value for
+    // non-negative floats (so buckets are finer near the camera). 0 for DRAW_ORDER_NONE.
+    static uint32_t depthBucket(float distance, DrawOrder order);
+
+    void clear();
+    void push(uint64_t key, uint32_t item);
+    void sort();
+
+    size_t size() const { return items_.size(); }
+    uint32_t item(size_t i) const { return items_[i]; } // in key order after sort()
+
+private:
+    std::vector<uint64_t> keys_, keysScratch_;
+    std::vector<uint32_t> items_, itemsScratch_;
+};
+
+#endif // MY_RENDER_QUEUE_HPP
@@ -0,0 +1,37 @@
+#ifndef MY_RENDER_STATS_HPP
+#define MY_RENDER_STATS_HPP
+
+#include <cstdint>
+#include <iostream>
+
+// GL binds and draws issued by the render thread. The drawing code bumps the
+// current frame's counters; the render loop folds them into a running total
+// once per frame. stateIssued/stateElided count the state changes that went
+// through GLStateCache or Shader's uniform cache: sent to GL, or skipped as
+// redundant. cullTested/cullRejected count frustum-culled mesh draws.
+struct RenderCounters {
+    uint64_t vaoBinds = 0;
+    uint64_t bufferBinds = 0;
+    uint64_t textureBinds = 0;
+    uint64_t drawCalls = 0;
+    uint64_t stateIssued = 0;
+    uint64_t stateElided = 0;
+    uint64_t cullTested = 0;   // mesh draws tested against the view frustum
+    uint64_t cullRejected = 0; // ... and skipped as outside it
+    uint64_t occlusionTested = 0;   // orbiters tested against the Earth or their last query
+    uint64_t occlusionRejected = 0; // ... and skipped as hidden
+
+    RenderCounters& operator+=(const RenderCounters& other);
+
+    // Averages over `frames`
+    void printPerFrame(uint64_t frames, std::ostream& os = std::cout) const;
+    void writeJsonPerFrame(uint64_t frames, std::ostream& os) const;
+};
+
+// This frame's counters (render thread only)
+RenderCounters& frameRenderCounters();
+
+// Add this frame's counters to `total` and start the next frame from zero
+void endRenderFrame(RenderCounters& total);
+
+#endif // MY_RENDER_STATS_HPP
@@ -0,0 +1,93 @@
+#ifndef MY_SCENE_HPP
+#define MY_SCENE_HPP
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <my_shader.hpp>
+#include <my_model.hpp>
+#include <my_batch.hpp>
+#include <my_frustum.hpp>
+#include <my_occlusion.hpp>
+#include <my_render_queue.hpp>
+#include <my_hands.hpp>
+#include <my_cli.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Global OpenGL state the scene expects (depth test, back-face culling)
+void configureGLState();
+
+// Unproject a window pixel (origin top-left) onto the plane planeDist in front of the camera
+glm::vec3 screenToWorldOnPlane(glm::mat4 view, glm::mat4 proj,
+                               int winW, int winH,
+                               glm::vec2 palmWinPx, float planeDist);
+
+// The Earth, its four orbiting Spitfires and the Moon. Shared by the
+// interactive app, headless mode and the benchmark executables. With
+// batched_submission the whole scene goes through one SceneBatch; otherwise
+// each mesh of each object is a RenderQueue item, sorted by shader, texture
+// set and depth. Either way, meshes outside the view frustum are skipped
+// (frustum_culling), and so are orbiters hidden behind the Earth
+// (occlusion_culling, occlusion_queries).
+class GlobeScene {
+public:
+    explicit GlobeScene(const CLIOptions& options);
+
+    // Advance the spin and orbit clocks
+    void update(float deltaTime);
+
+    // Move the Earth to the most confident hand that is close to the previous palm
+    void followHands(const std::vector<HandResult>& hands,
+                     const glm::mat4& view, const glm::mat4& projection,
+                     int winW, int winH, int frameW, int frameH);
+
+    // Draw all models (background is drawn separately)
+    void draw(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos);
+
+    const glm::vec3& earthPos() const { return earthPos_; }
+
+private:
+    CLIOptions options_;
+    Shader earthShader_;
+    Model earthModel_;
+    Model moonModel_;
+    Model spitfireModel_;
+    Shader batchShader_;
+    SceneBatch batch_;
+    DrawOrder drawOrder_ = DRAW_ORDER_FRONT_TO_BACK;
+
+    // One mesh of one object, for the render queue
+    struct SceneDraw {
+        Model* model;
+        size_t mesh;
+        size_t object;       // draws of one object share its model matrix
+        glm::mat4 transform; // the object's model matrix
+        glm::mat4 meshModel;
+        uint64_t key;
+    };
+    std::vector<SceneDraw> draws_;
+    SphereCuller culler_; // one sphere per draws_ entry
+    RenderQueue queue_;
+
+    // Orbiters (the Spitfires, then the Moon) as world-space spheres, and which are hidden this frame
+    std::vector<glm::vec4> orbiterSpheres_;
+    std::vector<uint8_t> orbiterHidden_;
+    std::unique_ptr<OcclusionQueries> occlusionQueries_;
+
+    float yRot_ = 0.0f;
+    float elapsedTime_ = 0.0f;
+    glm::vec3 earthPos_ = glm::vec3(0.0f);
+    glm::ivec2 prevPalmPos_;
+
+    // Batch handles, in the order the models are passed to batch_.build()
+    enum { BATCH_EARTH, BATCH_MOON, BATCH_SPITFIRE };
+
+    glm::mat4 spitfireMatrix_(const glm::mat4& earthTR, float theta) const;
+    void markHiddenOrbiters_(const glm::mat4& earthModel, const Frustum& frustum, const glm::vec3& eye);
+};
+
+#endif // MY_SCENE_HPP
@@ -4,7 +4,11 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <my_gl_state.hpp>
+#include <my_render_stats.hpp>
+
 #include <string>
+#include <unordered_map>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -75,61 +79,81 @@ public:
         glDeleteShader(fragment);
     }
 
-    // Activates the shader
+    // Activates the shader (skipped when it is already current)
     void use() {
-        glUseProgram(ID_);
+        glState().useProgram(ID_);
     }
 
     // Uniform functions
     void setBool(const std::string& name, bool value) const {
-        glUniform1i(glGetUniformLocation(ID_, name.c_str()), (int)value);
+        glUniform1i(location_(name), (int)value);
     }
 
+    // Int uniforms are mostly sampler units that never change, so writes of the current value are skipped
     void setInt(const std::string& name, int value) const {
-        glUniform1i(glGetUniformLocation(ID_, name.c_str()), value);
+        GLint location = location_(name);
+        auto it = intValues_.find(location);
+        if (it != intValues_.end() && it->second == value) {
+            ++frameRenderCounters().stateElided;
+            return;
+        }
+        ++frameRenderCounters().stateIssued;
+        intValues_[location] = value;
+        glUniform1i(location, value);
     }
 
     void setFloat(const std::string& name, float value) const {
-        glUniform1f(glGetUniformLocation(ID_, name.c_str()), value);
+        glUniform1f(location_(name), value);
     }
 
     void setVec2(const std::string& name, const glm::vec2& value) const {
-        glUniform2fv(glGetUniformLocation(ID_, name.c_str()), 1, &value[0]);
+        glUniform2fv(location_(name), 1, &value[0]);
     }
 
     void setVec2(const std::string& name, float x, float y) const {
-        glUniform2f(glGetUniformLocation(ID_, name.c_str()), x, y);
+        glUniform2f(location_(name), x, y);
     }
 
     void setVec3(const std::string& name, const glm::vec3& value) const {
-        glUniform3fv(glGetUniformLocation(ID_, name.c_str()), 1, &value[0]);
+        glUniform3fv(location_(name), 1, &value[0]);
     }
 
     void setVec3(const std::string& name, float x, float y, float z) const {
-        glUniform3f(glGetUniformLocation(ID_, name.c_str()), x, y, z);
+        glUniform3f(location_(name), x, y, z);
     }
 
     void setVec4(const std::string& name, const glm::vec4& value) const {
-        glUniform4fv(glGetUniformLocation(ID_, name.c_str()), 1, &value[0]);
+        glUniform4fv(location_(name), 1, &value[0]);
     }
 
     void setVec4(const std::string& name, float x, float y, float z, float w) const {
-        glUniform4f(glGetUniformLocation(ID_, name.c_str()), x, y, z, w);
+        glUniform4f(location_(name), x, y, z, w);
     }
 
     void setMat2(const std::string& name, const glm::mat2& mat) const {
-        glUniformMatrix2fv(glGetUniformLocation(ID_, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        glUniformMatrix2fv(location_(name), 1, GL_FALSE, &mat[0][0]);
     }
 
     void setMat3(const std::string& name, const glm::mat3& mat) const {
-        glUniformMatrix3fv(glGetUniformLocation(ID_, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        glUniformMatrix3fv(location_(name), 1, GL_FALSE, &mat[0][0]);
     }
 
     void setMat4(const std::string& name, const glm::mat4& mat) const {
-        glUniformMatrix4fv(glGetUniformLocation(ID_, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        glUniformMatrix4fv(location_(name), 1, GL_FALSE, &mat[0][0]);
     }
 
 private:
+    mutable std::unordered_map<std::string, GLint> locations_; // looked up once per name
+    mutable std::unordered_map<GLint, int> intValues_;         // last value written per int uniform
+
+    GLint location_(const std::string& name) const {
+        auto it = locations_.find(name);
+        if (it != locations_.end()) return it->second;
+        GLint location = glGetUniformLocation(ID_, name.c_str());
+        locations_.emplace(name, location);
+        return location;
+    }
+
     // Checks shader compilation/linking errors
     void checkCompileErrors(GLuint shader, std::string type) {
         GLint success;
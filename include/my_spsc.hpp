@@ -0,0 +1,130 @@
+#ifndef MY_SPSC_HPP
+#define MY_SPSC_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Wait-free single-producer/single-consumer primitives for handing frames and
+// detections between the capture, inference and render threads.
+
+// Keep producer- and consumer-owned indices on separate cache lines
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Bounded FIFO ring. Exactly one thread may push and one other thread may pop.
+// Each side keeps a private copy of the other side's index and only reloads
+// the shared atomic when the copy says the ring looks full/empty.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer: returns false if the ring is full
+    bool tryPush(const T& value) {
+        return emplace_(value);
+    }
+
+    bool tryPush(T&& value) {
+        return emplace_(std::move(value));
+    }
+
+    // Consumer: returns false if the ring is empty
+    bool tryPop(T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) return false;
+        }
+        value = std::move(slots_[head & (Capacity - 1)]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+private:
+    // Consumer side
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+
+    // Producer side
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;
+
+    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> slots_;
+
+    template <typename U>
+    bool emplace_(U&& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == Capacity) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == Capacity) return false;
+        }
+        slots_[tail & (Capacity - 1)] = std::forward<U>(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// "Latest value" triple buffer. The producer fills writeBuffer() and
+// publish()es it; the consumer calls update() and reads readBuffer(), always
+// seeing the newest published value and never blocking the producer. Buffers
+// are recycled, so large payloads (cv::Mat) keep their allocations. The
+// consumer must not hold references into readBuffer() across update().
+template <typename T>
+class LatestSlot
+{
+public:
+    // Producer: buffer to fill for the next publish()
+    T& writeBuffer() {
+        return buffers_[writeIndex_];
+    }
+
+    // Producer: make the write buffer the newest value
+    void publish() {
+        uint8_t previous = middle_.exchange(static_cast<uint8_t>(writeIndex_ | FRESH_BIT), std::memory_order_acq_rel);
+        writeIndex_ = previous & INDEX_MASK;
+    }
+
+    // Consumer: switch to the newest value; false if nothing new since last call
+    bool update() {
+        if ((middle_.load(std::memory_order_relaxed) & FRESH_BIT) == 0) return false;
+        uint8_t previous = middle_.exchange(readIndex_, std::memory_order_acq_rel);
+        readIndex_ = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Consumer: the value selected by the last successful update()
+    const T& readBuffer() const {
+        return buffers_[readIndex_];
+    }
+
+    T& readBuffer() {
+        return buffers_[readIndex_];
+    }
+
+private:
+    static constexpr uint8_t FRESH_BIT = 0x4;
+    static constexpr uint8_t INDEX_MASK = 0x3;
+
+    std::array<T, 3> buffers_{};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> middle_{1};
+    alignas(CACHE_LINE_SIZE) uint8_t writeIndex_ = 0;
+    alignas(CACHE_LINE_SIZE) uint8_t readIndex_ = 2;
+};
+
+#endif // MY_SPSC_HPP
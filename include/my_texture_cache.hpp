@@ -0,0 +1,151 @@
+#ifndef MY_TEXTURE_CACHE_HPP
+#define MY_TEXTURE_CACHE_HPP
+
+#include <my_timing.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// What a streamed texture shows until its first mip level is resident
+enum TexturePlaceholder {
+    PLACEHOLDER_GREY,       // mid grey (diffuse, bump)
+    PLACEHOLDER_FLAT_NORMAL // (0.5, 0.5, 1.0): an unperturbed tangent-space normal
+};
+
+// Process-wide cache of 2D textures shared by every Model, keyed by path and
+// content hash. Pair each acquire() with a release(). GL thread only.
+class TextureCache {
+public:
+    static TextureCache& instance();
+    ~TextureCache();
+
+    // Serve "foo.png" from "foo.ktx2" (MillCompressTexture) when present, fresh and supported
+    // (on by default); set before loading models
+    void setPreferCompressed(bool prefer) { preferCompressed_ = prefer; }
+
+    // acquire() returns a placeholder; a worker decodes and pumpUploads() fills in mips smallest
+    // first under the same texture id (off by default); set before loading models
+    void setStreaming(bool streaming) { streaming_ = streaming; }
+    void setUploadBudget(size_t bytesPerFrame) { uploadBudget_ = bytesPerFrame; }
+
+    // GL texture for the image at `path`, loaded on first use; 0 if it cannot be loaded.
+    // Streamed textures show `placeholder` until their data is resident.
+    unsigned int acquire(const std::string& path, TexturePlaceholder placeholder = PLACEHOLDER_GREY);
+    void release(unsigned int textureId);
+
+    // Streaming: upload decoded levels, at most the per-frame budget (0 = everything ready).
+    // Call once per frame on the GL thread.
+    void pumpUploads(size_t budget);
+    void pumpUploads() { pumpUploads(uploadBudget_); }
+
+    // Streaming: pump until every texture requested so far is fully resident
+    void finishUploads();
+
+    // True once nothing is waiting to be decoded or uploaded
+    bool allResident() const { return pendingTextures_ == 0; }
+    // Milliseconds from the first streamed acquire of the latest batch (acquires made while nothing
+    // was pending) to its last level resident (-1 until a batch completes)
+    double residentMs() const { return residentMs_; }
+    // Called from pumpUploads() each time an upload leaves nothing pending
+    void setResidentCallback(std::function<void(double residentMs)> callback) { onResident_ = std::move(callback); }
+
+    size_t textureCount() const { return entries_.size(); }
+    size_t textureBytes() const { return totalBytes_; }
+    uint64_t hits() const { return pathHits_ + contentHits_; }
+    uint64_t misses() const { return misses_; }
+    size_t compressedCount() const { return compressedCount_; }
+
+    void printStats(std::ostream& os = std::cout) const;
+
+private:
+    TextureCache() = default;
+
+    struct Entry {
+        std::string hash;
+        std::string canonicalPath;
+        size_t bytes = 0;   // estimated GPU memory, mip chain included
+        bool compressed = false;
+        unsigned int refs = 0;
+        uint64_t streamJob = 0; // streaming: job that will fill this texture, 0 when done
+    };
+
+    // Worker output: a full mip chain ready for upload, level 0 first
+    struct DecodedTexture {
+        uint64_t job = 0;
+        unsigned int textureId = 0;
+        std::string path;
+        std::string hash;
+        bool ok = false;
+        bool compressed = false;
+        unsigned int internalFormat = 0;
+        int width = 0;
+        int height = 0;
+        std::vector<std::vector<uint8_t>> levels;
+        // Upload progress (GL thread): next level, counting down, and rows of it already sent
+        size_t bytes = 0;
+        int nextLevel = -1;
+        int nextRow = 0;
+    };
+
+    struct DecodeJob {
+        uint64_t job = 0;
+        unsigned int textureId = 0;
+        std::string path;
+        std::string canonicalPath;
+        bool tryKtx2 = false;
+        bool s3tc = false;
+    };
+
+    std::unordered_map<std::string, unsigned int> byPath_; // canonical path -> texture
+    std::unordered_map<std::string, unsigned int> byHash_; // content hash -> texture
+    std::unordered_map<unsigned int, Entry> entries_;
+    size_t totalBytes_ = 0;
+    uint64_t pathHits_ = 0;
+    uint64_t contentHits_ = 0;
+    uint64_t misses_ = 0;
+    size_t compressedCount_ = 0;
+    bool preferCompressed_ = true;
+
+    // Streaming state; the queues below are shared with the worker under mutex_
+    bool streaming_ = false;
+    size_t uploadBudget_ = 4u << 20;
+    uint64_t nextJob_ = 1;
+    size_t pendingTextures_ = 0;
+    SteadyClock::time_point streamStart_;
+    double residentMs_ = -1.0;
+    std::function<void(double)> onResident_;
+    std::deque<DecodedTexture> uploads_; // GL thread only
+    std::vector<unsigned int> pbos_;
+    size_t nextPbo_ = 0;
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable decodedReady_;
+    std::deque<DecodeJob> jobs_;
+    std::deque<DecodedTexture> decoded_;
+    bool stopWorker_ = false;
+
+    void workerLoop_();
+    static void decode_(const DecodeJob& job, DecodedTexture& out);
+    unsigned int acquireStreamed_(const std::string& path, const std::string& canonical,
+                                  TexturePlaceholder placeholder);
+    // One PBO copy of part of the front upload; returns bytes sent
+    size_t uploadStep_(DecodedTexture& upload, size_t budget);
+    void finishTexture_(DecodedTexture& upload);
+    void textureDone_();
+
+    static unsigned int upload_(const std::string& encoded, const std::string& path, size_t& bytes);
+    static unsigned int uploadKtx2_(const std::string& encoded, const std::string& path, size_t& bytes);
+};
+
+#endif // MY_TEXTURE_CACHE_HPP
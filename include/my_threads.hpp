@@ -0,0 +1,51 @@
+#ifndef MY_THREADS_HPP
+#define MY_THREADS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Core lists like "2", "2,3" or "4-7"; empty = no pinning
+bool parseCoreList(const std::string& spec, std::vector<int>& cores, std::string& err);
+
+// Restrict the calling thread to `cores`. Threads it creates afterwards (e.g.
+// OpenCV's worker pool) inherit the mask.
+bool pinCurrentThread(const std::vector<int>& cores, std::string& err);
+
+// The calling thread's current affinity, to hand back to pinCurrentThread() later
+bool currentThreadCores(std::vector<int>& cores, std::string& err);
+
+// Raise the calling thread to SCHED_FIFO at `priority` (1-99), falling back to
+// the lowest nice value permitted without CAP_SYS_NICE
+bool raiseCurrentThreadPriority(int priority, std::string& err);
+
+// Affinity/priority for the pipeline's stage threads
+struct StageThreadConfig {
+    std::vector<int> captureCores;
+    std::vector<int> inferenceCores;
+    int capturePriority = 0; // 0 = leave unchanged
+};
+
+// Accounts one thread's CPU time (CLOCK_THREAD_CPUTIME_ID) and wall time from
+// construction until finish()/destruction, for the exit report
+class ThreadCpuScope {
+public:
+    explicit ThreadCpuScope(const char* name);
+    ~ThreadCpuScope();
+
+    void finish();
+
+private:
+    const char* name_;
+    int64_t cpuStartNs_;
+    int64_t wallStartNs_;
+    bool finished_;
+};
+
+// Per-thread CPU time, plus whatever the rest of the process (OpenCV and DNN
+// worker pools, driver threads) used
+void printThreadCpuReport(std::ostream& os = std::cout);
+
+#endif // MY_THREADS_HPP
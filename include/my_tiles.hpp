@@ -0,0 +1,59 @@
+#ifndef MY_TILES_HPP
+#define MY_TILES_HPP
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <vector>
+
+struct TilingParams {
+    bool enabled = false;
+    int tileSize = 0;              // tile side in frame pixels, 0 = detector input size (no downscale)
+    float overlap = 0.25f;         // fraction of a tile shared with each neighbour
+    unsigned int maxTiles = 4;     // per frame, on top of the whole-frame pass
+    float motionThreshold = 4.0f;  // mean grey-level change that makes a tile worth running
+};
+
+// Chooses which tiles of an overlapping grid the detector should look at in
+// full resolution this frame: the best tile for each existing track, then the
+// tiles with the most motion since the previous frame, then (if there is room)
+// one tile of a round-robin sweep so static hands are eventually found too.
+class TilePlanner {
+public:
+    void configure(const TilingParams& params);
+    const TilingParams& params() const { return params_; }
+    bool enabled() const { return params_.enabled; }
+
+    // Tiles for this frame, at most maxTiles; call once per frame
+    void select(const cv::Mat& frameBGR, const std::vector<cv::Rect>& tracks, int tileSize,
+                std::vector<cv::Rect>& tiles);
+
+    // Whole grid for the last frame size (e.g. for drawing)
+    const std::vector<cv::Rect>& grid() const { return grid_; }
+
+    uint64_t framesPlanned() const { return framesPlanned_; }
+    uint64_t tilesSelected() const { return tilesSelected_; }
+    double tilesPerFrame() const {
+        return framesPlanned_ ? static_cast<double>(tilesSelected_) / framesPlanned_ : 0.0;
+    }
+
+private:
+    TilingParams params_;
+
+    cv::Size gridFrameSize_;
+    int gridTileSize_ = 0;
+    std::vector<cv::Rect> grid_;
+    std::vector<float> energy_;
+    std::vector<int> order_;
+    std::vector<char> chosen_;
+    size_t sweepCursor_ = 0;
+
+    cv::Mat thumbnail_;   // current frame, grey and reduced
+    cv::Mat previous_;
+
+    uint64_t framesPlanned_ = 0;
+    uint64_t tilesSelected_ = 0;
+
+    void buildGrid_(cv::Size frameSize, int tileSize);
+};
+
+#endif // MY_TILES_HPP
@@ -0,0 +1,90 @@
+#ifndef MY_TIMING_HPP
+#define MY_TIMING_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using SteadyClock = std::chrono::steady_clock;
+
+// Milliseconds elapsed between two steady clock time points
+inline double elapsedMs(SteadyClock::time_point start, SteadyClock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Collects duration samples (ms) and summarises them
+class TimingStats
+{
+public:
+    void add(double ms) {
+        samples_.push_back(ms);
+    }
+
+    void clear() {
+        samples_.clear();
+    }
+
+    size_t count() const {
+        return samples_.size();
+    }
+
+    double total() const {
+        return std::accumulate(samples_.begin(), samples_.end(), 0.0);
+    }
+
+    double mean() const {
+        return samples_.empty() ? 0.0 : total() / static_cast<double>(samples_.size());
+    }
+
+    double min() const {
+        return samples_.empty() ? 0.0 : *std::min_element(samples_.begin(), samples_.end());
+    }
+
+    double max() const {
+        return samples_.empty() ? 0.0 : *std::max_element(samples_.begin(), samples_.end());
+    }
+
+    // Nearest-rank percentile, p in [0, 100]
+    double percentile(double p) const {
+        if (samples_.empty()) return 0.0;
+        std::vector<double> sorted(samples_);
+        std::sort(sorted.begin(), sorted.end());
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+        return sorted[rank - 1];
+    }
+
+    // One-line human readable summary
+    void printSummary(const std::string& label, std::ostream& os = std::cout) const {
+        os << std::fixed << std::setprecision(3)
+           << label << ": n=" << count()
+           << " mean=" << mean() << "ms"
+           << " p50=" << percentile(50.0) << "ms"
+           << " p95=" << percentile(95.0) << "ms"
+           << " p99=" << percentile(99.0) << "ms"
+           << " min=" << min() << "ms"
+           << " max=" << max() << "ms" << std::endl;
+    }
+
+    // Summary as a JSON object (values in ms)
+    void writeJson(std::ostream& os) const {
+        os << std::fixed << std::setprecision(4)
+           << "{\"count\": " << count()
+           << ", \"mean\": " << mean()
+           << ", \"p50\": " << percentile(50.0)
+           << ", \"p95\": " << percentile(95.0)
+           << ", \"p99\": " << percentile(99.0)
+           << ", \"min\": " << min()
+           << ", \"max\": " << max() << "}";
+    }
+
+private:
+    std::vector<double> samples_;
+};
+
+#endif // MY_TIMING_HPP
@@ -0,0 +1,82 @@
+#ifndef MY_TRACE_HPP
+#define MY_TRACE_HPP
+
+#include <my_timing.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Lightweight scoped-timer instrumentation dumped as Chrome trace_event JSON
+// (open in chrome://tracing or ui.perfetto.dev).
+//
+// Each thread writes complete ("X") events into its own fixed-size ring
+// buffer, so recording takes no locks; only a thread's first event registers
+// its buffer. When tracing is disabled a scope costs one relaxed load and a
+// well-predicted branch. Event names must be string literals (or otherwise
+// outlive the dump) because only the pointer is stored.
+struct TraceEvent {
+    const char* name;
+    int64_t startNs;
+    int64_t durNs;
+};
+
+class Tracer {
+public:
+    static bool enabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+    static void setEnabled(bool enabled);
+
+    // Label the calling thread in the trace viewer
+    static void setThreadName(const char* name);
+
+    // Append a complete event to the calling thread's ring buffer
+    static void record(const char* name, int64_t startNs, int64_t endNs);
+
+    // Write every thread's buffered events as trace_event JSON
+    static bool dump(const std::string& path, std::string& errMsg);
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            SteadyClock::now().time_since_epoch()).count();
+    }
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+// Times the enclosing scope
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name_(name), startNs_(Tracer::enabled() ? Tracer::nowNs() : 0) {}
+
+    ~TraceScope() {
+        if (startNs_ != 0) {
+            Tracer::record(name_, startNs_, Tracer::nowNs());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    int64_t startNs_;
+};
+
+// Record a span that was already timed with SteadyClock
+inline void traceSpan(const char* name, SteadyClock::time_point start, SteadyClock::time_point end) {
+    if (Tracer::enabled()) {
+        Tracer::record(name,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end.time_since_epoch()).count());
+    }
+}
+
+#define MY_TRACE_CONCAT_INNER(a, b) a##b
+#define MY_TRACE_CONCAT(a, b) MY_TRACE_CONCAT_INNER(a, b)
+#define MY_TRACE_SCOPE(name) TraceScope MY_TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#endif // MY_TRACE_HPP
@@ -7,15 +7,31 @@
 #include <opencv2/videoio.hpp>
 #include <string>
 #include <iostream>
+#include <cstdint>
 
 class MyWebcam
 {
 public:
+    // deviceName is a V4L2 device (/dev/videoN), a recorded video file, or
+    // "synthetic" for generated frames stamped with their capture time
     MyWebcam(const std::string camName, const std::string deviceName, 
         int frameWidth, int frameHeight, int FPS);
     ~MyWebcam();
     int readFrame(cv::Mat& frame, std::string& errMsg);
 
+    // readFrame split into capture (grab) and decode (retrieve) for profiling
+    int grabFrame(std::string& errMsg);
+    int retrieveFrame(cv::Mat& frame, std::string& errMsg);
+
+    // Seek a video file source back to its first frame
+    bool rewind();
+    bool isFile() const { return isFile_; }
+    bool isSynthetic() const { return isSynthetic_; }
+
+    // Monotonic capture time (ns) of the last grabbed frame: the V4L2 driver
+    // buffer timestamp when available, otherwise the time grab() returned
+    int64_t lastCaptureNs() const { return lastCaptureNs_; }
+
 private:
     cv::VideoCapture cap_;
     std::string camName_;
@@ -23,6 +39,11 @@ private:
     int frameWidth_;
     int frameHeight_;
     int FPS_;
+    bool isFile_;
+    bool isSynthetic_;
+    uint64_t frameCounter_;
+    int64_t lastCaptureNs_;
+    cv::Mat syntheticFrame_;
 };
 
-#endif // MY_WEBCAM_HPP
\ No newline at end of file
+#endif // MY_WEBCAM_HPP
@@ -8,8 +8,17 @@
 #include <my_hands.hpp>
 #include <my_cli.hpp>
 #include <my_bg_quad.hpp>
+#include <my_scene.hpp>
+#include <my_headless.hpp>
+#include <my_timing.hpp>
+#include <my_trace.hpp>
+#include <my_latency.hpp>
+#include <my_render_stats.hpp>
+#include <my_pipeline.hpp>
+#include <my_threads.hpp>
 
 #include <iostream>
+#include <memory>
 #include <random>
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -18,14 +27,17 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <opencv2/videoio.hpp>
+#include <opencv2/imgcodecs.hpp>
 
 // Callback function declarations
 void frameBufferSizeCallback(GLFWwindow* window, int width, int height);
 void processUserInput(GLFWwindow* window);
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 
 // Global params for callback functions
 int screenWidth;
 int screenHeight;
+std::string tracePath;
 
 int setupGLFW(GLFWwindow** window) {
     // glfw init and configure
@@ -52,6 +64,7 @@ int setupGLFW(GLFWwindow** window) {
 
     // Callback functions
     glfwSetFramebufferSizeCallback(glfw_window, frameBufferSizeCallback);
+    glfwSetKeyCallback(glfw_window, keyCallback);
 
     // Show cursor, for debugging
     glfwSetInputMode(glfw_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
@@ -64,11 +77,7 @@ int setupGLFW(GLFWwindow** window) {
     *window = glfw_window;
 
     // Configure global OpenGL state
-    glEnable(GL_DEPTH_TEST);    // Depth-testing
-    glDepthFunc(GL_LESS);       // Smaller value as "closer" for depth-testing
-    glEnable(GL_CULL_FACE);     // Cull back faces to reduce fragment work
-    glCullFace(GL_BACK);    
-    glFrontFace(GL_CCW);
+    configureGLState();
 
     // Initialize viewport to current framebuffer size
     int fbw = 0, fbh = 0;
@@ -81,32 +90,16 @@ int setupGLFW(GLFWwindow** window) {
     return 0;
 }
 
-// Inputs: view, proj (glm::mat4), winW, winH, palmWinPx (window pixels, origin top-left), planeDist d
-glm::vec3 screenToWorldOnPlane(glm::mat4 view, glm::mat4 proj,
-                               int winW, int winH,
-                               glm::vec2 palmWinPx, float planeDist) {
-    glm::ivec4 viewport(0, 0, winW, winH);
-
-    // glm::unProject expects origin at bottom-left: flip Y
-    glm::vec3 winNear(palmWinPx.x, float(winH) - palmWinPx.y, 0.0f);
-    glm::vec3 winFar (palmWinPx.x, float(winH) - palmWinPx.y, 1.0f);
-
-    glm::vec3 pNear = glm::unProject(winNear, view, proj, viewport);
-    glm::vec3 pFar  = glm::unProject(winFar,  view, proj, viewport);
-    glm::vec3 dir   = glm::normalize(pFar - pNear);
-
-    // Camera world pose and forward
-    glm::mat4 invV = glm::inverse(view);
-    glm::vec3 camPos = glm::vec3(invV[3]);
-    glm::vec3 camFwd = glm::normalize(glm::vec3(invV * glm::vec4(0, 0, -1, 0))); // -Z in view space
-
-    // Plane: point at camPos + d*camFwd, normal = camFwd
-    glm::vec3 planePoint = camPos + camFwd * planeDist;
-    float denom = glm::dot(dir, camFwd);
-    if (fabs(denom) < 1e-6f) return pNear; // nearly parallel; fallback
-
-    float t = glm::dot(planePoint - pNear, camFwd) / denom;
-    return pNear + t * dir;
+// Offscreen alternative to setupGLFW: EGL context rendering into an FBO
+int setupHeadless(std::unique_ptr<HeadlessContext>& ctx) {
+    ctx = std::make_unique<HeadlessContext>(screenWidth, screenHeight);
+    std::string errMsg;
+    if (!ctx->initialize(errMsg)) {
+        std::cout << "Failed to create headless context: " << errMsg << std::endl;
+        return -1;
+    }
+    configureGLState();
+    return 0;
 }
 
 int main(int argc, char** argv) {
@@ -120,21 +113,52 @@ int main(int argc, char** argv) {
     // Set global params
     screenWidth = options.screenWidth;
     screenHeight = options.screenHeight;
+    tracePath = options.tracePath;
+    Tracer::setEnabled(options.traceEnabled);
+    Tracer::setThreadName("render");
 
-    // Window
+    // Window, or offscreen context when headless
     GLFWwindow* window = nullptr;
-    if (setupGLFW(&window) != 0) {
+    std::unique_ptr<HeadlessContext> headlessCtx;
+    if (options.headless) {
+        if (setupHeadless(headlessCtx) != 0) {
+            std::cerr << "Failed to setup headless rendering. Exiting.\n";
+            return -1;
+        }
+    } else if (setupGLFW(&window) != 0) {
         std::cerr << "Failed to setup GLFW. Exiting.\n";
         return -1;
     }
 
-    // Shaders (Background shader handled inside class)
-    Shader earthShader(options.earthVertexShaderPath.c_str(), options.earthFragmentShaderPath.c_str());
+    // Stage thread affinity
+    std::string handErr;
+    StageThreadConfig threadConfig;
+    threadConfig.capturePriority = options.capturePriority;
+    if (!parseCoreList(options.captureCores, threadConfig.captureCores, handErr)
+        || !parseCoreList(options.inferenceCores, threadConfig.inferenceCores, handErr)) {
+        std::cerr << "Warning: " << handErr << " (stage threads unpinned)" << std::endl;
+        threadConfig.captureCores.clear();
+        threadConfig.inferenceCores.clear();
+    }
+
+    // Hand tracker setup
+    HandTracker handTracker;
+    if (!configureHandTracker(handTracker, options, handErr)) {
+        std::cerr << "HandTracker load failed: " << handErr << std::endl;
+        return -1;
+    }
 
-    // Models
-    Model earthModel(options.earthModelPath, "Earth");
-    Model moonModel(options.moonModelPath, "Moon");
-    Model spitfireModel(options.spitfireModelPath, "Spitfire");
+    // Shaders and models (Background shader handled inside class)
+    TextureCache& textures = TextureCache::instance();
+    textures.setPreferCompressed(options.compressedTextures);
+    textures.setStreaming(options.textureStreaming);
+    textures.setUploadBudget(static_cast<size_t>(options.textureUploadBudgetKb) * 1024);
+    textures.setResidentCallback([](double residentMs) {
+        std::cout << "All textures resident after " << residentMs << " ms" << std::endl;
+    });
+    auto sceneStart = SteadyClock::now();
+    GlobeScene scene(options);
+    textures.printStats();
 
     // Virtual camera
     Camera camera;
@@ -146,238 +170,212 @@ int main(int argc, char** argv) {
     camera.setZoomEnabled(false);
 
     // Webcam (For device name, run: $ v4l2-ctl --list-devices)
-    MyWebcam webcam(options.webcamName, options.deviceName, screenWidth, screenHeight, options.fps);
-    cv::Mat currentFrame(cv::Size(screenWidth, screenHeight), CV_8UC3);
-    std::string errMsg;
-    int initRead = webcam.readFrame(currentFrame, errMsg);
-    if (initRead != 0) {
-        std::cerr << "Warning: " << errMsg << " (continuing; will retry each frame)" << std::endl;
-        currentFrame.release();
-    }
-
-    // Hand tracker setup 
-    HandTracker handTracker;
-    std::string handErr;
-    bool handsReady = handTracker.load(options.onnxModelPath, screenWidth, options.applySmoothing, handErr);
-    if (!handsReady) {
-        std::cerr << "HandTracker load failed: " << handErr << std::endl;
-        return -1;
-    } else {
-        // Prefer GPU if available; else fall back to default
-        handTracker.setBackendTarget(cv::dnn::DNN_BACKEND_CUDA, cv::dnn::DNN_TARGET_CUDA);
+    // Headless hosts usually have no camera: render the scene without a background
+    std::unique_ptr<MyWebcam> webcam;
+    try {
+        webcam = std::make_unique<MyWebcam>(options.webcamName, options.deviceName, screenWidth, screenHeight, options.fps);
+    } catch (const std::exception& e) {
+        if (!options.headless) {
+            std::cerr << e.what() << std::endl;
+            return -1;
+        }
+        std::cerr << "Warning: " << e.what() << " (headless; rendering without background)" << std::endl;
     }
 
     // Background Quad
     BackgroundQuad bgQuad(options.bgVertexShaderPath, options.bgFragmentShaderPath);
     bgQuad.initialize();
 
+    // Capture and detection run on their own threads; the render loop takes the newest of each
+    std::unique_ptr<FramePipeline> pipeline;
+    if (webcam) {
+        pipeline = std::make_unique<FramePipeline>(*webcam, handTracker, options.fps);
+        pipeline->setThreadConfig(threadConfig);
+        pipeline->start();
+    }
+
+    // Pin the render thread only now, so the stage threads don't inherit its mask
+    std::vector<int> renderCores;
+    if (!parseCoreList(options.renderCores, renderCores, handErr) || !pinCurrentThread(renderCores, handErr)) {
+        std::cerr << "Warning: render affinity: " << handErr << std::endl;
+    }
+
+    // Headless output must not depend on how far streaming got
+    if (options.headless) {
+        textures.finishUploads();
+    }
+
     // Render loop
-    float yRot = 0.0f;
     float deltaTime = 0.0f;
     float prevFrame = 0.0f;
-    float elapsedTime = 0.0f;
-    glm::vec3 earthPos = glm::vec3(0.0f);
-    cv::Point2i prevPalmPos(screenWidth / 2, screenHeight / 2);
-    while (!glfwWindowShouldClose(window))
+    unsigned int frameCount = 0;
+    TimingStats frameStats;
+    LatencyTracker latency;
+    RenderCounters glCalls;
+    unsigned int stampsChecked = 0, stampMismatches = 0;
+    const bool verifyStamps = options.latencyReport && headlessCtx && webcam && webcam->isSynthetic();
+    auto renderStart = SteadyClock::now();
+    ThreadCpuScope renderCpu("render");
+    while (options.headless ? frameCount < options.headlessFrames : !glfwWindowShouldClose(window))
     {
+        auto frameStart = SteadyClock::now();
+
         // Clear screen colour and buffers
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // Per-frame time logic
-        float currentTime = static_cast<float>(glfwGetTime());
+        // Per-frame time logic (fixed step when headless so output is reproducible)
+        float currentTime = options.headless
+            ? static_cast<float>(frameCount) / static_cast<float>(std::max(options.fps, 1u))
+            : static_cast<float>(glfwGetTime());
         deltaTime = currentTime - prevFrame;
-        elapsedTime += deltaTime;
         prevFrame = currentTime;
-
-        // Rotate the model slowly about the y-axis
-        yRot += 20.0f * deltaTime;
-        yRot = fmodf(yRot, 360.0f);
+        scene.update(deltaTime);
 
         // Process user input
-        processUserInput(window);
-
-        // Update webcam texture (and optionally overlay hands) at most ~30 fps
-        std::vector<HandResult> hands;
-        if (webcam.readFrame(currentFrame, errMsg) == 0) {
-            // Run hand tracker on the fresh frame
-            hands = handTracker.infer(currentFrame);
+        if (window) {
+            processUserInput(window);
         }
 
-        // Update webcam texture
-        bgQuad.updateTexture(currentFrame);
+        // Update webcam texture when the capture thread has a newer frame
+        FrameStamps stamps;
+        stamps.frameId = frameCount;
+        if (pipeline && pipeline->pollFrame()) {
+            bgQuad.updateTexture(pipeline->frame().frame);
+            stamps.captureNs = pipeline->frame().captureNs;
+        }
 
         // Render background quad
         bgQuad.render();
 
         // Setup uniforms in shaders
-        glm::mat4 model = glm::identity<glm::mat4>();
         glm::mat4 view = camera.getViewMatrix();
         glm::mat4 projection = glm::perspective(glm::radians(camera.zoom_),
             static_cast<float>(screenWidth) / static_cast<float>(screenHeight), 
             0.1f, 1000.0f);
 
-        // Updated logic to use the center of the detected hand ROI
-        if (!hands.empty()) {
-            // Only do one hand for now: highest confidence score
-            HandResult bestHand = hands[0];
-            for (const auto& hr : hands) {
-                if (hr.score > bestHand.score) { 
-                    bestHand = hr;
-                }
+        // Use the center of the newest detected hand ROI to place the Earth
+        if (pipeline && pipeline->pollDetections()) {
+            const DetectionPacket& detections = pipeline->detections();
+            scene.followHands(detections.hands, view, projection, screenWidth, screenHeight,
+                              detections.frameSize.width, detections.frameSize.height);
+        }
+        if (pipeline) {
+            stamps.detectNs = pipeline->detections().detectNs;
+            stamps.detectCaptureNs = pipeline->detections().captureNs;
+        }
+
+        // Earth, Spitfires and Moon (streamed textures sharpen as their mips arrive)
+        textures.pumpUploads();
+        scene.draw(view, projection, camera.position_);
+        stamps.drawNs = monotonicNowNs();
+
+        // Swap buffers and poll events (headless: wait for the GPU instead)
+        if (headlessCtx) {
+            MY_TRACE_SCOPE("HeadlessContext::finish");
+            headlessCtx->finish();
+        } else {
+            {
+                MY_TRACE_SCOPE("glfwSwapBuffers");
+                glfwSwapBuffers(window);
             }
-            
-            // Check if plausible match (nearby to previous palm, starting in centre of frame)
-            cv::Point2i handPalmPos = bestHand.roi.tl() + cv::Point2i(bestHand.roi.width / 2, bestHand.roi.height / 2);
-            float distToPrevPalm = cv::norm(handPalmPos - prevPalmPos);
-            if (distToPrevPalm < 100.0f) {
-                // Use bounding box center of best hand as palm point
-                if (handPalmPos.x >= 0 && handPalmPos.y >= 0 && handPalmPos.x < currentFrame.cols && handPalmPos.y < currentFrame.rows) {
-                    glm::vec2 palmVideoPx(handPalmPos.x, handPalmPos.y - 15); // Small nudge higher (+Y axis is down in image coords)
-                    glm::ivec2 winSize(screenWidth, screenHeight);
-                    glm::vec2 palmWinPx = palmVideoPx; // assuming webcam fills window; adjust if letterboxed
-                    earthPos = screenToWorldOnPlane(view, projection, winSize.x, winSize.y, palmWinPx, options.initPosition.z);
-                }
-                prevPalmPos = handPalmPos;
+            glfwPollEvents();
+        }
+        stamps.presentNs = monotonicNowNs();
+        if (frameCount == 0) {
+            std::cout << "First frame " << elapsedMs(sceneStart, SteadyClock::now()) << " ms after scene load started"
+                << std::endl;
+        }
+
+        // Synthetic frames: the stamp read back from the framebuffer must be this frame's
+        if (verifyStamps && stamps.captureNs != 0) {
+            cv::Mat presented;
+            uint16_t shownId = 0;
+            int64_t shownCaptureNs = 0;
+            ++stampsChecked;
+            if (!headlessCtx->readPixels(presented) || !decodeFrameStamp(presented, shownId, shownCaptureNs)
+                || shownCaptureNs != stamps.captureNs / 1000 * 1000) {
+                ++stampMismatches;
             }
-        } 
-
-        // Slightly scale down to keep fully within the frame
-        model = glm::scale(model, glm::vec3(options.earthScale));
-        model = glm::rotate(model, glm::radians(yRot), glm::vec3(0.0f, 1.0f, 0.0f));
-        model = glm::translate(glm::mat4(1.0f), earthPos) * model;
-
-        // Set shader uniforms
-        earthShader.use();
-        earthShader.setMat4("model", model);
-        earthShader.setMat4("view", view);
-        earthShader.setMat4("projection", projection);
-
-        // Lighting uniforms for current shader (world space)
-        earthShader.setVec3("lightPos", glm::vec3(5.0f, 0.0f, 5.0f)); 
-        earthShader.setVec3("viewPos", camera.position_);
-        earthShader.setFloat("shininess", 32.0f);
-        earthModel.draw(earthShader);
-
-        // Earth transform without scale: translation to earthPos and Earth rotation
-        glm::mat4 earthTR = glm::translate(glm::mat4(1.0f), earthPos) *
-                            glm::rotate(glm::mat4(1.0f), glm::radians(yRot), glm::vec3(0.0f, 1.0f, 0.0f));
-
-        // Orbit in Earth's local XZ plane (equator)
-        float theta = glm::radians(elapsedTime * options.spitfireOrbitSpeedDeg);
-        glm::vec3 orbitPos = glm::vec3(
-            options.spitfireOrbitRadius * cosf(theta),
-            0.0f,
-            options.spitfireOrbitRadius * sinf(theta)
-        );
-
-        // Tangent direction along the orbit (forward direction) in Earth-local frame
-        glm::vec3 forward = glm::normalize(glm::vec3(-sinf(theta), 0.0f, cosf(theta)));
-        glm::vec3 up(0.0f, 1.0f, 0.0f); // Earth's up
-        glm::vec3 right = glm::normalize(glm::cross(forward, up));
-
-        // Recompute up to ensure orthonormal basis
-        up = glm::normalize(glm::cross(right, forward));
-
-        // Columns are the basis vectors (Earth-local): right, up, forward
-        glm::mat4 basis(1.0f);
-        basis[0] = glm::vec4(right, 0.0f);
-        basis[1] = glm::vec4(up, 0.0f);
-        basis[2] = glm::vec4(forward, 0.0f);
-
-        // Compose spitfire relative to Earth: Earth TR -> orbit translate -> orientation -> local roll -> scale
-        glm::mat4 planeModel = earthTR
-            * glm::translate(glm::mat4(1.0f), orbitPos)
-            * basis
-            * glm::rotate(glm::mat4(1.0f), glm::radians(-45.0f), glm::vec3(0.0f, 0.0f, 1.0f))
-            * glm::scale(glm::mat4(1.0f), glm::vec3(options.spitfireScale));
-        earthShader.setMat4("model", planeModel);
-
-        // Apply per-mesh transform to spin propeller meshes
-        float propAngle = (2.0f * M_PI) * options.propellerRps * elapsedTime; // radians
-        spitfireModel.drawWithTransforms(earthShader, [&](const std::string& meshName) -> glm::mat4 {
-            std::string lower = meshName;
-            for (char& c : lower) c = static_cast<char>(::tolower(c));
-            if (lower.find("prop") != std::string::npos) {
-                return glm::rotate(glm::mat4(1.0f), propAngle, options.propellerAxis);
+        }
+        if (options.latencyReport) {
+            latency.record(stamps);
+        }
+        if (pipeline) {
+            InferenceStamp inference;
+            while (pipeline->popInferenceStamp(inference)) {
+                if (options.latencyReport) latency.recordInference(inference.captureNs, inference.detectNs);
             }
-            return glm::mat4(1.0f);
-        }); 
-
-        // Render four Spitfires spaced 90 degrees apart
-        for (int i = 0; i < 4; ++i) {
-            float angleOffset = glm::radians(90.0f * i);
-            float adjustedTheta = theta + angleOffset;
-
-            glm::vec3 adjustedOrbitPos = glm::vec3(
-                options.spitfireOrbitRadius * cosf(adjustedTheta),
-                0.0f,
-                options.spitfireOrbitRadius * sinf(adjustedTheta)
-            );
-
-            glm::vec3 adjustedForward = glm::normalize(glm::vec3(-sinf(adjustedTheta), 0.0f, cosf(adjustedTheta)));
-            glm::vec3 adjustedRight = glm::normalize(glm::cross(adjustedForward, up));
-            glm::vec3 adjustedUp = glm::normalize(glm::cross(adjustedRight, adjustedForward));
-
-            glm::mat4 adjustedBasis(1.0f);
-            adjustedBasis[0] = glm::vec4(adjustedRight, 0.0f);
-            adjustedBasis[1] = glm::vec4(adjustedUp, 0.0f);
-            adjustedBasis[2] = glm::vec4(adjustedForward, 0.0f);
-
-            glm::mat4 adjustedPlaneModel = earthTR
-                * glm::translate(glm::mat4(1.0f), adjustedOrbitPos)
-                * adjustedBasis
-                * glm::rotate(glm::mat4(1.0f), glm::radians(-45.0f), glm::vec3(0.0f, 0.0f, 1.0f))
-                * glm::scale(glm::mat4(1.0f), glm::vec3(options.spitfireScale));
-
-            earthShader.setMat4("model", adjustedPlaneModel);
-
-            spitfireModel.drawWithTransforms(earthShader, [&](const std::string& meshName) -> glm::mat4 {
-                std::string lower = meshName;
-                for (char& c : lower) c = static_cast<char>(::tolower(c));
-                if (lower.find("prop") != std::string::npos) {
-                    return glm::rotate(glm::mat4(1.0f), propAngle, options.propellerAxis);
-                }
-                return glm::mat4(1.0f);
-            });
         }
+        frameStats.add(elapsedMs(frameStart, SteadyClock::now()));
+        endRenderFrame(glCalls);
+        ++frameCount;
+    }
+
+    renderCpu.finish();
+    if (pipeline) {
+        pipeline->stop();
+    }
+
+    // Timing summary
+    double totalSec = elapsedMs(renderStart, SteadyClock::now()) / 1000.0;
+    frameStats.printSummary("Frame time");
+    glCalls.printPerFrame(frameCount);
+    std::cout << "Rendered " << frameCount << " frames in " << totalSec << "s ("
+        << (totalSec > 0.0 ? frameCount / totalSec : 0.0) << " fps)" << std::endl;
+
+    // Detector work saved by the motion gate
+    if (options.motionGate) {
+        const MotionGate& gate = handTracker.motionGate();
+        std::cout << "Motion gate skipped the detector on " << gate.framesSkipped() << "/" << gate.framesSeen()
+            << " frames (" << 100.0 * gate.skippedFraction() << "%)" << std::endl;
+    }
+    if (options.tiledDetection) {
+        const TilePlanner& tiles = handTracker.tilePlanner();
+        std::cout << "Tiled detection ran " << tiles.tilesPerFrame() << " of " << tiles.grid().size()
+            << " tiles per frame on average" << std::endl;
+    }
+
+    // Where the CPU went: named stage threads vs OpenCV/DNN worker pools
+    printThreadCpuReport();
+
+    // Glass-to-glass latency distribution
+    if (options.latencyReport) {
+        latency.printSummary();
+        if (pipeline && pipeline->droppedInferenceStamps() > 0) {
+            std::cout << "Latency report missed " << pipeline->droppedInferenceStamps()
+                << " inference stamps (render thread fell behind)" << std::endl;
+        }
+    }
+    if (verifyStamps) {
+        std::cout << "Synthetic stamp check: " << (stampsChecked - stampMismatches) << "/" << stampsChecked
+            << " presented frames carried their own capture stamp" << std::endl;
+    }
+
+    // Flush trace events collected this session
+    if (Tracer::enabled()) {
+        std::string traceErr;
+        if (!Tracer::dump(tracePath, traceErr)) {
+            std::cerr << traceErr << std::endl;
+        }
+    }
 
-        // Moon orbit parameters
-        float moonTheta = glm::radians(elapsedTime * options.moonOrbitSpeedDeg);
-        glm::vec3 moonOrbitPos = glm::vec3(
-            options.moonOrbitRadius * cosf(moonTheta),
-            0.0f,
-            options.moonOrbitRadius * sinf(moonTheta)
-        );
-
-        // Compute moon orientation to always face Earth
-        glm::vec3 moonForward = glm::normalize(-moonOrbitPos); // Point towards Earth
-        glm::vec3 moonRight = glm::normalize(glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), moonForward));
-        glm::vec3 moonUp = glm::normalize(glm::cross(moonForward, moonRight));
-
-        glm::mat4 moonBasis(1.0f);
-        moonBasis[0] = glm::vec4(moonRight, 0.0f);
-        moonBasis[1] = glm::vec4(moonUp, 0.0f);
-        moonBasis[2] = glm::vec4(moonForward, 0.0f);
-
-        glm::mat4 moonModelMatrix = earthTR
-            * glm::translate(glm::mat4(1.0f), moonOrbitPos)
-            * moonBasis
-            * glm::scale(glm::mat4(1.0f), glm::vec3(options.moonScale));
-
-        // Ensure the moon model uses its own texture
-        earthShader.setMat4("model", moonModelMatrix);
-        moonModel.draw(earthShader);
-
-        // Swap buffers and poll events
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    // Golden image of the final headless frame
+    if (headlessCtx && !options.headlessOutput.empty()) {
+        cv::Mat finalFrame;
+        if (headlessCtx->readPixels(finalFrame) && cv::imwrite(options.headlessOutput, finalFrame)) {
+            std::cout << "Wrote final frame to " << options.headlessOutput << std::endl;
+        } else {
+            std::cerr << "Failed to write final frame to " << options.headlessOutput << std::endl;
+        }
     }
 
     // Clean up and exit
-    glfwDestroyWindow(window);
-    glfwTerminate();
-    return 0;
+    if (window) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
+    return stampMismatches == 0 ? 0 : 1;
 }
 
 // Process keyboard inputs
@@ -390,6 +388,16 @@ void processUserInput(GLFWwindow* window) {
     }
 }
 
+// Discrete key presses ('T' dumps the trace collected so far)
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    if (key == GLFW_KEY_T && action == GLFW_PRESS && Tracer::enabled()) {
+        std::string traceErr;
+        if (!Tracer::dump(tracePath, traceErr)) {
+            std::cerr << traceErr << std::endl;
+        }
+    }
+}
+
 // Window size change callback
 void frameBufferSizeCallback(GLFWwindow* window, int width, int height) {
     // Prevent zero dimension viewport
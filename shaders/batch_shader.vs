@@ -0,0 +1,30 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aTexCoords;
+layout(location = 3) in uint aDrawId; // per instance: this draw's slot in drawData
+
+out vec2 TexCoords;
+out vec3 FragPos;
+out vec3 Normal;
+
+uniform samplerBuffer drawData; // per draw: model * meshModel, one column per texel
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    int base = int(aDrawId) * 4;
+    mat4 combined = mat4(texelFetch(drawData, base),
+                         texelFetch(drawData, base + 1),
+                         texelFetch(drawData, base + 2),
+                         texelFetch(drawData, base + 3));
+    FragPos = vec3(combined * vec4(aPos, 1.0));
+
+    Normal = mat3(transpose(inverse(combined))) * aNormal; // Transform normal to world space
+
+    TexCoords = aTexCoords;
+
+    gl_Position = projection * view * combined * vec4(aPos, 1.0);
+}
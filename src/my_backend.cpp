@@ -0,0 +1,164 @@
+#include <my_backend.hpp>
+
+#include <opencv2/core.hpp>
+#include <opencv2/core/cuda.hpp>
+#include <opencv2/dnn.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+bool parseInferenceEngine(const std::string& name, InferenceEngine& engine) {
+    if (name == "opencv") {
+        engine = ENGINE_OPENCV_DNN;
+    } else if (name == "onnxruntime") {
+        engine = ENGINE_ONNXRUNTIME;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool lookupCandidate(const std::string& name, BackendCandidate& candidate) {
+    using namespace cv::dnn;
+    candidate.name = name;
+    if (name == "cuda") {
+        candidate.backend = DNN_BACKEND_CUDA; candidate.target = DNN_TARGET_CUDA;
+    } else if (name == "cuda_fp16") {
+        candidate.backend = DNN_BACKEND_CUDA; candidate.target = DNN_TARGET_CUDA_FP16;
+    } else if (name == "openvino") {
+        candidate.backend = DNN_BACKEND_INFERENCE_ENGINE; candidate.target = DNN_TARGET_CPU;
+    } else if (name == "opencl") {
+        candidate.backend = DNN_BACKEND_OPENCV; candidate.target = DNN_TARGET_OPENCL;
+    } else if (name == "opencl_fp16") {
+        candidate.backend = DNN_BACKEND_OPENCV; candidate.target = DNN_TARGET_OPENCL_FP16;
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 9)
+    } else if (name == "cpu_fp16") {
+        candidate.backend = DNN_BACKEND_OPENCV; candidate.target = DNN_TARGET_CPU_FP16;
+#endif
+    } else if (name == "cpu") {
+        candidate.backend = DNN_BACKEND_OPENCV; candidate.target = DNN_TARGET_CPU;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseBackendList(const std::string& spec, std::vector<BackendCandidate>& candidates, std::string& err) {
+    candidates.clear();
+    std::stringstream ss(spec);
+    std::string name;
+    while (std::getline(ss, name, ',')) {
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t") + 1);
+        if (name.empty()) continue;
+        BackendCandidate candidate;
+        if (!lookupCandidate(name, candidate)) {
+            // e.g. cpu_fp16 before OpenCV 4.9: the rest of the list is still worth trying
+            std::cerr << "Warning: unknown or unsupported DNN backend '" << name << "', skipped" << std::endl;
+            continue;
+        }
+        candidates.push_back(candidate);
+    }
+    if (candidates.empty()) {
+        err = "No usable DNN backends in '" + spec + "'";
+        return false;
+    }
+    return true;
+}
+
+static uint64_t fnv1a(const char* data, size_t size, uint64_t hash = 1469598103934665603ULL) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static std::string toHex(uint64_t value) {
+    std::ostringstream os;
+    os << std::hex;
+    os.width(16);
+    os.fill('0');
+    os << value;
+    return os.str();
+}
+
+std::string hashString(const std::string& data) {
+    return toHex(fnv1a(data.data(), data.size()));
+}
+
+bool hashFile(const std::string& path, std::string& hexDigest, std::string& err) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        err = "Could not open " + path + " for hashing";
+        return false;
+    }
+    uint64_t hash = 1469598103934665603ULL;
+    std::vector<char> buffer(1 << 16);
+    while (in) {
+        in.read(buffer.data(), buffer.size());
+        hash = fnv1a(buffer.data(), static_cast<size_t>(in.gcount()), hash);
+    }
+    hexDigest = toHex(hash);
+    return true;
+}
+
+std::string backendMachineId() {
+    std::ostringstream id;
+
+    char host[256] = {0};
+    if (gethostname(host, sizeof(host) - 1) == 0) {
+        id << host;
+    }
+
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            id << "|" << line.substr(line.find(':') + 1);
+            break;
+        }
+    }
+
+    id << "|opencv " << CV_VERSION << "|cuda devices " << cv::cuda::getCudaEnabledDeviceCount();
+    return id.str();
+}
+
+bool loadCachedBackend(const std::string& cachePath, const std::string& key, std::string& backendName) {
+    if (cachePath.empty()) return false;
+    try {
+        YAML::Node cache = YAML::LoadFile(cachePath);
+        if (cache[key] && cache[key]["backend"]) {
+            backendName = cache[key]["backend"].as<std::string>();
+            return true;
+        }
+    } catch (const std::exception&) {
+        // Missing or unreadable cache: benchmark again
+    }
+    return false;
+}
+
+bool storeCachedBackend(const std::string& cachePath, const std::string& key,
+                        const std::string& backendName, double forwardMs, std::string& err) {
+    if (cachePath.empty()) return true;
+    YAML::Node cache;
+    try {
+        cache = YAML::LoadFile(cachePath);
+    } catch (const std::exception&) {
+        cache = YAML::Node(YAML::NodeType::Map);
+    }
+    cache[key]["backend"] = backendName;
+    cache[key]["forward_ms"] = forwardMs;
+
+    std::ofstream out(cachePath);
+    if (!out) {
+        err = "Could not write backend cache " + cachePath;
+        return false;
+    }
+    out << cache << "\n";
+    return true;
+}
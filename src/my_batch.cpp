@@ -0,0 +1,275 @@
+#include <my_batch.hpp>
+#include <my_gl_state.hpp>
+#include <my_render_stats.hpp>
+#include <my_trace.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+static bool sameTextures(const std::vector<Texture>& a, const std::vector<Texture>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].type != b[i].type) return false;
+    }
+    return true;
+}
+
+static bool texturesBefore(const std::vector<Texture>& a, const std::vector<Texture>& b) {
+    for (size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
+        if (a[i].id != b[i].id) return a[i].id < b[i].id;
+        if (a[i].type != b[i].type) return a[i].type < b[i].type;
+    }
+    return a.size() < b.size();
+}
+
+SceneBatch::~SceneBatch() {
+    deleteBuffers_();
+}
+
+void SceneBatch::deleteBuffers_() {
+    if (VAO_ == 0) return;
+    glState().deleteVertexArray(VAO_);
+    GLuint buffers[] = {VBO_, EBO_, drawIdBuffer_, drawDataBuffer_, indirectBuffer_};
+    glDeleteBuffers(5, buffers);
+    glState().deleteTexture(drawDataTexture_);
+    VAO_ = VBO_ = EBO_ = drawIdBuffer_ = drawDataBuffer_ = indirectBuffer_ = drawDataTexture_ = 0;
+    drawIdCapacity_ = 0;
+}
+
+void SceneBatch::build(const std::vector<const Model*>& models, bool allowIndirect) {
+    MY_TRACE_SCOPE("SceneBatch::build");
+    deleteBuffers_();
+    meshes_.clear();
+    modelFirstMesh_.clear();
+    indirect_ = allowIndirect && GLAD_GL_VERSION_4_3 && glMultiDrawElementsIndirect != nullptr;
+
+    size_t totalVertices = 0, totalIndices = 0;
+    for (const Model* model : models) {
+        totalVertices += model->vertexCount();
+        totalIndices += model->indexCount();
+    }
+
+    glGenVertexArrays(1, &VAO_);
+    glGenBuffers(1, &VBO_);
+    glGenBuffers(1, &EBO_);
+    glGenBuffers(1, &drawIdBuffer_);
+    glGenBuffers(1, &drawDataBuffer_);
+    glGenBuffers(1, &indirectBuffer_);
+    glGenTextures(1, &drawDataTexture_);
+
+    glState().bindVertexArray(VAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+    glBufferData(GL_ARRAY_BUFFER, totalVertices * sizeof(Vertex), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, totalIndices * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+
+    // Straight from each model's buffers; the CPU copies may already be gone
+    size_t vertexBase = 0, indexBase = 0;
+    for (const Model* model : models) {
+        modelFirstMesh_.push_back(meshes_.size());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, VBO_);
+        glBindBuffer(GL_COPY_READ_BUFFER, model->vertexBuffer());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, vertexBase * sizeof(Vertex),
+                            model->vertexCount() * sizeof(Vertex));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, EBO_);
+        glBindBuffer(GL_COPY_READ_BUFFER, model->indexBuffer());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, indexBase * sizeof(unsigned int),
+                            model->indexCount() * sizeof(unsigned int));
+        for (const Mesh& mesh : model->meshes()) {
+            BatchMesh batchMesh;
+            batchMesh.indexCount = static_cast<GLsizei>(mesh.indexCount());
+            batchMesh.firstIndex = static_cast<GLuint>(indexBase + mesh.firstIndex());
+            batchMesh.baseVertex = static_cast<GLint>(vertexBase) + mesh.baseVertex();
+            batchMesh.name = mesh.meshName_;
+            batchMesh.center = mesh.boundsCenter();
+            batchMesh.radius = mesh.boundsRadius();
+            batchMesh.textures = mesh.textures_;
+            meshes_.push_back(std::move(batchMesh));
+        }
+        vertexBase += model->vertexCount();
+        indexBase += model->indexCount();
+    }
+    modelFirstMesh_.push_back(meshes_.size());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    // Same layout as Model's VAO, plus the per-instance draw id
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    ensureDrawIds_(256);
+    pointDrawIds_(0);
+    glState().bindVertexArray(0);
+
+    // Matrices as RGBA32F texels, four per draw
+    glBindBuffer(GL_TEXTURE_BUFFER, drawDataBuffer_);
+    glBufferData(GL_TEXTURE_BUFFER, sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+    glState().bindTexture(DRAW_DATA_UNIT, GL_TEXTURE_BUFFER, drawDataTexture_);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, drawDataBuffer_);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // Fixed command order: meshes sorted by texture set, one group per set
+    order_.resize(meshes_.size());
+    std::iota(order_.begin(), order_.end(), 0);
+    std::stable_sort(order_.begin(), order_.end(), [&](size_t a, size_t b) {
+        return texturesBefore(meshes_[a].textures, meshes_[b].textures);
+    });
+    groups_.clear();
+    for (size_t i = 0; i < order_.size(); ++i) {
+        const std::vector<Texture>& textures = meshes_[order_[i]].textures;
+        if (groups_.empty() || !sameTextures(groups_.back().textures, textures)) {
+            groups_.push_back({textures, i, 0});
+        }
+        ++groups_.back().count;
+    }
+    commands_.resize(order_.size());
+
+    std::cout << "Scene batch: " << models.size() << " model(s), " << meshes_.size() << " mesh(es), "
+              << groups_.size() << " texture group(s), "
+              << (indirect_ ? "glMultiDrawElementsIndirect" : "instanced base-vertex draws (no GL 4.3)") << std::endl;
+}
+
+void SceneBatch::ensureDrawIds_(size_t count) {
+    if (count <= drawIdCapacity_) return;
+    drawIdCapacity_ = std::max(count, drawIdCapacity_ * 2);
+    std::vector<GLuint> ids(drawIdCapacity_);
+    std::iota(ids.begin(), ids.end(), 0u);
+    glBindBuffer(GL_ARRAY_BUFFER, drawIdBuffer_);
+    glBufferData(GL_ARRAY_BUFFER, ids.size() * sizeof(GLuint), ids.data(), GL_STATIC_DRAW);
+    ++frameRenderCounters().bufferBinds;
+}
+
+// Attribute 3 starts at draw `first` (the GL 3.3 stand-in for baseInstance); needs the VAO bound
+void SceneBatch::pointDrawIds_(size_t first) {
+    glBindBuffer(GL_ARRAY_BUFFER, drawIdBuffer_);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)(first * sizeof(GLuint)));
+    ++frameRenderCounters().bufferBinds;
+}
+
+void SceneBatch::clear() {
+    for (BatchMesh& mesh : meshes_) {
+        mesh.instances.clear();
+    }
+}
+
+void SceneBatch::add(int handle, const glm::mat4& transform) {
+    for (size_t m = modelFirstMesh_[handle]; m < modelFirstMesh_[handle + 1]; ++m) {
+        meshes_[m].instances.push_back(transform);
+    }
+}
+
+void SceneBatch::add(int handle, const glm::mat4& transform,
+                     const std::function<glm::mat4(const std::string&)>& meshTransform) {
+    for (size_t m = modelFirstMesh_[handle]; m < modelFirstMesh_[handle + 1]; ++m) {
+        meshes_[m].instances.push_back(meshTransform ? transform * meshTransform(meshes_[m].name) : transform);
+    }
+}
+
+size_t SceneBatch::cull(const Frustum& frustum) {
+    MY_TRACE_SCOPE("SceneBatch::cull");
+    culler_.clear();
+    for (const BatchMesh& mesh : meshes_) {
+        for (const glm::mat4& transform : mesh.instances) {
+            culler_.push(transform, mesh.center, mesh.radius);
+        }
+    }
+    const size_t culled = culler_.cull(frustum);
+
+    // Compact each mesh's copies in place, keeping their order
+    size_t sphere = 0;
+    for (BatchMesh& mesh : meshes_) {
+        size_t kept = 0;
+        for (size_t k = 0; k < mesh.instances.size(); ++k, ++sphere) {
+            if (culler_.visible(sphere)) mesh.instances[kept++] = mesh.instances[k];
+        }
+        mesh.instances.resize(kept);
+    }
+    RenderCounters& counters = frameRenderCounters();
+    counters.cullTested += culler_.size();
+    counters.cullRejected += culled;
+    return culled;
+}
+
+void SceneBatch::bindTextures_(Shader& shader, const std::vector<Texture>& textures) {
+    for (unsigned int i = 0; i < static_cast<unsigned int>(textures.size()); i++) {
+        shader.setInt(textures[i].type, i);
+        glState().bindTexture(i, GL_TEXTURE_2D, textures[i].id);
+    }
+}
+
+void SceneBatch::submit(Shader& shader, const glm::mat4& view, DrawOrder order) {
+    MY_TRACE_SCOPE("SceneBatch::submit");
+    RenderCounters& counters = frameRenderCounters();
+
+    // Commands and per-draw matrices, instances of a mesh contiguous
+    drawData_.clear();
+    for (size_t i = 0; i < order_.size(); ++i) {
+        const BatchMesh& mesh = meshes_[order_[i]];
+        commands_[i] = {static_cast<GLuint>(mesh.indexCount), static_cast<GLuint>(mesh.instances.size()),
+                        mesh.firstIndex, mesh.baseVertex, static_cast<GLuint>(drawData_.size())};
+        if (mesh.instances.size() < 2) {
+            drawData_.insert(drawData_.end(), mesh.instances.begin(), mesh.instances.end());
+            continue;
+        }
+        // Instances rasterize in order, so sorting them gets early-Z rejection inside one draw.
+        // DRAW_ORDER_NONE gives every copy depth 0, and the stable sort keeps them in submission order.
+        instanceQueue_.clear();
+        for (size_t k = 0; k < mesh.instances.size(); ++k) {
+            const float depth = -(view * mesh.instances[k] * glm::vec4(mesh.center, 1.0f)).z;
+            instanceQueue_.push(RenderQueue::depthBucket(depth, order), static_cast<uint32_t>(k));
+        }
+        instanceQueue_.sort();
+        for (size_t k = 0; k < instanceQueue_.size(); ++k) {
+            drawData_.push_back(mesh.instances[instanceQueue_.item(k)]);
+        }
+    }
+    drawCount_ = drawData_.size();
+    apiCalls_ = 0;
+    if (drawData_.empty()) return;
+
+    // Orphan and refill: the GPU may still be reading last frame's data
+    glBindBuffer(GL_TEXTURE_BUFFER, drawDataBuffer_);
+    glBufferData(GL_TEXTURE_BUFFER, drawData_.size() * sizeof(glm::mat4), drawData_.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    counters.bufferBinds += 2;
+    glState().bindTexture(DRAW_DATA_UNIT, GL_TEXTURE_BUFFER, drawDataTexture_);
+    shader.setInt("drawData", DRAW_DATA_UNIT);
+
+    glState().bindVertexArray(VAO_);
+    ensureDrawIds_(drawData_.size());
+    if (indirect_) {
+        // Draw ids stay at offset 0 (set in build); baseInstance selects each command's range
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer_);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands_.size() * sizeof(DrawCommand), commands_.data(), GL_STREAM_DRAW);
+        ++counters.bufferBinds;
+        for (const TextureGroup& group : groups_) {
+            bindTextures_(shader, group.textures);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                                        (void*)(group.first * sizeof(DrawCommand)),
+                                        static_cast<GLsizei>(group.count), 0);
+            ++apiCalls_;
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        ++counters.bufferBinds;
+    } else {
+        for (const TextureGroup& group : groups_) {
+            bindTextures_(shader, group.textures);
+            for (size_t i = group.first; i < group.first + group.count; ++i) {
+                const DrawCommand& cmd = commands_[i];
+                if (cmd.instanceCount == 0) continue;
+                pointDrawIds_(cmd.baseInstance);
+                glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(cmd.count), GL_UNSIGNED_INT,
+                                                  (void*)(cmd.firstIndex * sizeof(unsigned int)),
+                                                  static_cast<GLsizei>(cmd.instanceCount), cmd.baseVertex);
+                ++apiCalls_;
+            }
+        }
+    }
+    counters.drawCalls += apiCalls_;
+}
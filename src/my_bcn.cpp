@@ -0,0 +1,163 @@
+#include <my_bcn.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+static inline uint16_t packRgb565(int r, int g, int b) {
+    return static_cast<uint16_t>(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+static inline void unpackRgb565(uint16_t c, int rgb[3]) {
+    const int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// Colour half of a BC1/BC3 block. Endpoints are the extremes of the block's
+// colours along their principal axis (approximated by the bounding box
+// diagonal, with its sign fixed by the green/red covariance), always in the
+// four-colour (c0 > c1) mode, so no texel turns transparent.
+static void encodeColourBlock(const uint8_t* rgba, uint8_t* out) {
+    int lo[3] = {255, 255, 255}, hi[3] = {0, 0, 0};
+    int mean[3] = {0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            lo[c] = std::min(lo[c], static_cast<int>(rgba[4 * i + c]));
+            hi[c] = std::max(hi[c], static_cast<int>(rgba[4 * i + c]));
+            mean[c] += rgba[4 * i + c];
+        }
+    }
+    for (int c = 0; c < 3; ++c) mean[c] = (mean[c] + 8) / 16;
+
+    // Flip the diagonal for channels that fall while green rises
+    int axis[3] = {hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]};
+    int covRG = 0, covBG = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int dg = rgba[4 * i + 1] - mean[1];
+        covRG += (rgba[4 * i + 0] - mean[0]) * dg;
+        covBG += (rgba[4 * i + 2] - mean[2]) * dg;
+    }
+    if (covRG < 0) axis[0] = -axis[0];
+    if (covBG < 0) axis[2] = -axis[2];
+
+    int minDot = 1 << 30, maxDot = -(1 << 30), minIdx = 0, maxIdx = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int dot = rgba[4 * i] * axis[0] + rgba[4 * i + 1] * axis[1] + rgba[4 * i + 2] * axis[2];
+        if (dot < minDot) { minDot = dot; minIdx = i; }
+        if (dot > maxDot) { maxDot = dot; maxIdx = i; }
+    }
+    uint16_t c0 = packRgb565(rgba[4 * maxIdx], rgba[4 * maxIdx + 1], rgba[4 * maxIdx + 2]);
+    uint16_t c1 = packRgb565(rgba[4 * minIdx], rgba[4 * minIdx + 1], rgba[4 * minIdx + 2]);
+
+    uint32_t indices = 0;
+    if (c0 == c1) {
+        // Flat block: every texel is c0 (index 0)
+    } else {
+        if (c0 < c1) std::swap(c0, c1);
+        int palette[4][3];
+        unpackRgb565(c0, palette[0]);
+        unpackRgb565(c1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestError = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                const int dr = rgba[4 * i] - palette[p][0];
+                const int dg = rgba[4 * i + 1] - palette[p][1];
+                const int db = rgba[4 * i + 2] - palette[p][2];
+                const int error = dr * dr + dg * dg + db * db;
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= static_cast<uint32_t>(best) << (2 * i);
+        }
+    }
+    out[0] = c0 & 0xff; out[1] = c0 >> 8;
+    out[2] = c1 & 0xff; out[3] = c1 >> 8;
+    for (int b = 0; b < 4; ++b) out[4 + b] = (indices >> (8 * b)) & 0xff;
+}
+
+// BC3 alpha block: endpoints are the alpha range, eight interpolated steps (a0 > a1 mode)
+static void encodeAlphaBlock(const uint8_t* rgba, uint8_t* out) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max(a0, static_cast<int>(rgba[4 * i + 3]));
+        a1 = std::min(a1, static_cast<int>(rgba[4 * i + 3]));
+    }
+    out[0] = static_cast<uint8_t>(a0);
+    out[1] = static_cast<uint8_t>(a1);
+    uint64_t indices = 0;
+    if (a0 > a1) {
+        int palette[8];
+        palette[0] = a0;
+        palette[1] = a1;
+        for (int p = 1; p < 7; ++p) palette[p + 1] = ((7 - p) * a0 + p * a1) / 7;
+        for (int i = 0; i < 16; ++i) {
+            const int a = rgba[4 * i + 3];
+            int best = 0, bestError = 1 << 30;
+            for (int p = 0; p < 8; ++p) {
+                const int error = std::abs(a - palette[p]);
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+    for (int b = 0; b < 6; ++b) out[2 + b] = (indices >> (8 * b)) & 0xff;
+}
+
+void compressBc1Block(const uint8_t* rgba, uint8_t* out) {
+    encodeColourBlock(rgba, out);
+}
+
+void compressBc3Block(const uint8_t* rgba, uint8_t* out) {
+    encodeAlphaBlock(rgba, out);
+    encodeColourBlock(rgba, out + 8);
+}
+
+void compressImage(const uint8_t* rgba, int width, int height, BlockFormat format, std::vector<uint8_t>& out) {
+    const int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    const size_t bytes = blockBytes(format);
+    out.resize(static_cast<size_t>(blocksX) * blocksY * bytes);
+    uint8_t block[64];
+    uint8_t* dst = out.data();
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            for (int y = 0; y < 4; ++y) {
+                const int sy = std::min(by * 4 + y, height - 1);
+                for (int x = 0; x < 4; ++x) {
+                    const int sx = std::min(bx * 4 + x, width - 1);
+                    std::memcpy(block + 4 * (4 * y + x), rgba + 4 * (static_cast<size_t>(sy) * width + sx), 4);
+                }
+            }
+            if (format == BLOCK_BC1) {
+                compressBc1Block(block, dst);
+            } else {
+                compressBc3Block(block, dst);
+            }
+            dst += bytes;
+        }
+    }
+}
+
+void downsampleRgba(const uint8_t* rgba, int width, int height, std::vector<uint8_t>& out,
+                    int& outWidth, int& outHeight) {
+    outWidth = std::max(1, width / 2);
+    outHeight = std::max(1, height / 2);
+    out.resize(static_cast<size_t>(outWidth) * outHeight * 4);
+    for (int y = 0; y < outHeight; ++y) {
+        const int y0 = std::min(2 * y, height - 1), y1 = std::min(2 * y + 1, height - 1);
+        for (int x = 0; x < outWidth; ++x) {
+            const int x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+            for (int c = 0; c < 4; ++c) {
+                const int sum = rgba[4 * (static_cast<size_t>(y0) * width + x0) + c]
+                              + rgba[4 * (static_cast<size_t>(y0) * width + x1) + c]
+                              + rgba[4 * (static_cast<size_t>(y1) * width + x0) + c]
+                              + rgba[4 * (static_cast<size_t>(y1) * width + x1) + c];
+                out[4 * (static_cast<size_t>(y) * outWidth + x) + c] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+}
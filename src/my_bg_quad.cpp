@@ -1,13 +1,16 @@
 #include <my_bg_quad.hpp>
+#include <my_gl_state.hpp>
+#include <my_render_stats.hpp>
+#include <my_trace.hpp>
 #include <iostream>
 
 BackgroundQuad::BackgroundQuad(const std::string& vertexShaderPath, const std::string& fragmentShaderPath)
     : bgShader_(vertexShaderPath.c_str(), fragmentShaderPath.c_str()), bgVAO_(0), bgVBO_(0), webcamTex_(0), camW_(0), camH_(0) {}
 
 BackgroundQuad::~BackgroundQuad() {
-    glDeleteVertexArrays(1, &bgVAO_);
+    glState().deleteVertexArray(bgVAO_);
     glDeleteBuffers(1, &bgVBO_);
-    glDeleteTextures(1, &webcamTex_);
+    glState().deleteTexture(webcamTex_);
 }
 
 void BackgroundQuad::initialize() {
@@ -23,7 +26,7 @@ void BackgroundQuad::initialize() {
     glGenVertexArrays(1, &bgVAO_);
     glGenBuffers(1, &bgVBO_);
 
-    glBindVertexArray(bgVAO_);
+    glState().bindVertexArray(bgVAO_);
     glBindBuffer(GL_ARRAY_BUFFER, bgVBO_);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
@@ -32,22 +35,22 @@ void BackgroundQuad::initialize() {
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
 
-    glBindVertexArray(0);
+    glState().bindVertexArray(0);
 
     // Setup texture
     glGenTextures(1, &webcamTex_);
-    glBindTexture(GL_TEXTURE_2D, webcamTex_);
+    glState().bindTexture(0, GL_TEXTURE_2D, webcamTex_);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void BackgroundQuad::updateTexture(const cv::Mat& frame) {
+    MY_TRACE_SCOPE("BackgroundQuad::updateTexture");
     if (frame.empty()) return;
 
-    glBindTexture(GL_TEXTURE_2D, webcamTex_);
+    glState().bindTexture(0, GL_TEXTURE_2D, webcamTex_);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
     if (frame.cols != camW_ || frame.rows != camH_) {
@@ -71,21 +74,17 @@ void BackgroundQuad::updateTexture(const cv::Mat& frame) {
     } else {
         glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, camW_, camH_, dataFormat_, GL_UNSIGNED_BYTE, frame.data);
     }
-
-    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void BackgroundQuad::render() {
     if (camW_ > 0 && camH_ > 0) {
-        glDisable(GL_DEPTH_TEST);
+        // Nothing is unbound or re-enabled afterwards: the scene sets what it needs through glState()
+        glState().disable(GL_DEPTH_TEST);
         bgShader_.use();
         bgShader_.setInt("uFrame", 0);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, webcamTex_);
-        glBindVertexArray(bgVAO_);
+        glState().bindTexture(0, GL_TEXTURE_2D, webcamTex_);
+        glState().bindVertexArray(bgVAO_);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        glBindVertexArray(0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glEnable(GL_DEPTH_TEST);
+        ++frameRenderCounters().drawCalls;
     }
 }
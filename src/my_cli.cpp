@@ -92,6 +92,34 @@ CLIOptions parseCli(int argc, char** argv) {
             } else {
                 std::cerr << "Missing value for --onnx_input_size\n";
             }
+        } else if (isFlag(a, "--detector_sizes", "--sizes")) {
+            if (i + 1 < args.size()) {
+                opts.detectorSizes = args[++i];
+            } else {
+                std::cerr << "Missing value for --detector_sizes\n";
+            }
+        } else if (isFlag(a, "--detector_budget_ms", "--budget")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.detectorBudgetMs = std::stof(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid float for --detector_budget_ms\n";
+                }
+            } else {
+                std::cerr << "Missing value for --detector_budget_ms\n";
+            }
+        } else if (isFlag(a, "--int8_model_path", "--int8_model")) {
+            if (i + 1 < args.size()) {
+                opts.int8ModelPath = args[++i];
+            } else {
+                std::cerr << "Missing value for --int8_model_path\n";
+            }
+        } else if (isFlag(a, "--detector_precision", "--precision")) {
+            if (i + 1 < args.size()) {
+                opts.detectorPrecision = args[++i];
+            } else {
+                std::cerr << "Missing value for --detector_precision\n";
+            }
         } else if (isFlag(a, "--apply_smoothing", "--smoothing")) {
             if (i + 1 < args.size()) {
                 std::string val = args[++i];
@@ -105,6 +133,207 @@ CLIOptions parseCli(int argc, char** argv) {
             } else {
                 std::cerr << "Missing value for --apply_smoothing\n";
             }
+        } else if (isFlag(a, "--inference_engine", "--engine")) {
+            if (i + 1 < args.size()) {
+                opts.inferenceEngine = args[++i];
+            } else {
+                std::cerr << "Missing value for --inference_engine\n";
+            }
+        } else if (isFlag(a, "--ort_intra_op_threads", "--ort_threads")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.ortIntraOpThreads = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --ort_intra_op_threads\n";
+                }
+            } else {
+                std::cerr << "Missing value for --ort_intra_op_threads\n";
+            }
+        } else if (isFlag(a, "--dnn_backends", "--backends")) {
+            if (i + 1 < args.size()) {
+                opts.dnnBackends = args[++i];
+            } else {
+                std::cerr << "Missing value for --dnn_backends\n";
+            }
+        } else if (isFlag(a, "--backend_cache_path", "--backend_cache")) {
+            if (i + 1 < args.size()) {
+                opts.backendCachePath = args[++i];
+            } else {
+                std::cerr << "Missing value for --backend_cache_path\n";
+            }
+        } else if (isFlag(a, "--dnn_fusion", "--fusion")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.dnnFusion = true;
+                } else if (val == "false" || val == "0") {
+                    opts.dnnFusion = false;
+                } else {
+                    std::cerr << "Invalid value for --dnn_fusion; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --dnn_fusion\n";
+            }
+        } else if (isFlag(a, "--detector_warmup_runs", "--warmup_runs")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.detectorWarmupRuns = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --detector_warmup_runs\n";
+                }
+            } else {
+                std::cerr << "Missing value for --detector_warmup_runs\n";
+            }
+        } else if (isFlag(a, "--nms_mode", "--nms")) {
+            if (i + 1 < args.size()) {
+                opts.nmsMode = args[++i];
+            } else {
+                std::cerr << "Missing value for --nms_mode\n";
+            }
+        } else if (isFlag(a, "--nms_iou_threshold", "--nms_iou")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.nmsIouThreshold = std::stof(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid float for --nms_iou_threshold\n";
+                }
+            } else {
+                std::cerr << "Missing value for --nms_iou_threshold\n";
+            }
+        } else if (isFlag(a, "--nms_sigma", "--nms_sigma")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.nmsSigma = std::stof(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid float for --nms_sigma\n";
+                }
+            } else {
+                std::cerr << "Missing value for --nms_sigma\n";
+            }
+        } else if (isFlag(a, "--motion_gate", "--motion")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.motionGate = true;
+                } else if (val == "false" || val == "0") {
+                    opts.motionGate = false;
+                } else {
+                    std::cerr << "Invalid value for --motion_gate; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --motion_gate\n";
+            }
+        } else if (isFlag(a, "--motion_threshold", "--motion_threshold")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.motionThreshold = std::stof(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid float for --motion_threshold\n";
+                }
+            } else {
+                std::cerr << "Missing value for --motion_threshold\n";
+            }
+        } else if (isFlag(a, "--motion_max_age", "--motion_max_age")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.motionMaxAge = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --motion_max_age\n";
+                }
+            } else {
+                std::cerr << "Missing value for --motion_max_age\n";
+            }
+        } else if (isFlag(a, "--tiled_detection", "--tiles")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.tiledDetection = true;
+                } else if (val == "false" || val == "0") {
+                    opts.tiledDetection = false;
+                } else {
+                    std::cerr << "Invalid value for --tiled_detection; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --tiled_detection\n";
+            }
+        } else if (isFlag(a, "--tile_size", "--tile_size")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.tileSize = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --tile_size\n";
+                }
+            } else {
+                std::cerr << "Missing value for --tile_size\n";
+            }
+        } else if (isFlag(a, "--tile_overlap", "--tile_overlap")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.tileOverlap = std::stof(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid float for --tile_overlap\n";
+                }
+            } else {
+                std::cerr << "Missing value for --tile_overlap\n";
+            }
+        } else if (isFlag(a, "--max_tiles", "--max_tiles")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.maxTiles = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --max_tiles\n";
+                }
+            } else {
+                std::cerr << "Missing value for --max_tiles\n";
+            }
+        } else if (isFlag(a, "--tile_motion_threshold", "--tile_motion_threshold")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.tileMotionThreshold = std::stof(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid float for --tile_motion_threshold\n";
+                }
+            } else {
+                std::cerr << "Missing value for --tile_motion_threshold\n";
+            }
+        } else if (isFlag(a, "--inference_threads", "--threads")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.inferenceThreads = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --inference_threads\n";
+                }
+            } else {
+                std::cerr << "Missing value for --inference_threads\n";
+            }
+        } else if (isFlag(a, "--capture_cores", "--capture_cores")) {
+            if (i + 1 < args.size()) {
+                opts.captureCores = args[++i];
+            } else {
+                std::cerr << "Missing value for --capture_cores\n";
+            }
+        } else if (isFlag(a, "--inference_cores", "--inference_cores")) {
+            if (i + 1 < args.size()) {
+                opts.inferenceCores = args[++i];
+            } else {
+                std::cerr << "Missing value for --inference_cores\n";
+            }
+        } else if (isFlag(a, "--render_cores", "--render_cores")) {
+            if (i + 1 < args.size()) {
+                opts.renderCores = args[++i];
+            } else {
+                std::cerr << "Missing value for --render_cores\n";
+            }
+        } else if (isFlag(a, "--capture_priority", "--capture_priority")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.capturePriority = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --capture_priority\n";
+                }
+            } else {
+                std::cerr << "Missing value for --capture_priority\n";
+            }
         } else if (isFlag(a, "--camera_speed", "--cam_speed")) {
             if (i + 1 < args.size()) {
                 try {
@@ -165,6 +394,113 @@ CLIOptions parseCli(int argc, char** argv) {
             } else {
                 std::cerr << "Missing value for --earth_scale\n";
             }
+        } else if (isFlag(a, "--compressed_textures", "--compressed_textures")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.compressedTextures = true;
+                } else if (val == "false" || val == "0") {
+                    opts.compressedTextures = false;
+                } else {
+                    std::cerr << "Invalid value for --compressed_textures; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --compressed_textures\n";
+            }
+        } else if (isFlag(a, "--texture_streaming", "--texture_streaming")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.textureStreaming = true;
+                } else if (val == "false" || val == "0") {
+                    opts.textureStreaming = false;
+                } else {
+                    std::cerr << "Invalid value for --texture_streaming; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --texture_streaming\n";
+            }
+        } else if (isFlag(a, "--texture_upload_budget_kb", "--texture_upload_budget_kb")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.textureUploadBudgetKb = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --texture_upload_budget_kb\n";
+                }
+            } else {
+                std::cerr << "Missing value for --texture_upload_budget_kb\n";
+            }
+        } else if (isFlag(a, "--keep_mesh_data", "--keep_mesh_data")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.keepMeshData = true;
+                } else if (val == "false" || val == "0") {
+                    opts.keepMeshData = false;
+                } else {
+                    std::cerr << "Invalid value for --keep_mesh_data; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --keep_mesh_data\n";
+            }
+        } else if (isFlag(a, "--batched_submission", "--batched_submission")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.batchedSubmission = true;
+                } else if (val == "false" || val == "0") {
+                    opts.batchedSubmission = false;
+                } else {
+                    std::cerr << "Invalid value for --batched_submission; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --batched_submission\n";
+            }
+        } else if (isFlag(a, "--draw_order", "--draw_order")) {
+            if (i + 1 < args.size()) {
+                opts.drawOrder = args[++i];
+            } else {
+                std::cerr << "Missing value for --draw_order\n";
+            }
+        } else if (isFlag(a, "--frustum_culling", "--frustum_culling")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.frustumCulling = true;
+                } else if (val == "false" || val == "0") {
+                    opts.frustumCulling = false;
+                } else {
+                    std::cerr << "Invalid value for --frustum_culling; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --frustum_culling\n";
+            }
+        } else if (isFlag(a, "--occlusion_culling", "--occlusion_culling")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.occlusionCulling = true;
+                } else if (val == "false" || val == "0") {
+                    opts.occlusionCulling = false;
+                } else {
+                    std::cerr << "Invalid value for --occlusion_culling; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --occlusion_culling\n";
+            }
+        } else if (isFlag(a, "--occlusion_queries", "--occlusion_queries")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.occlusionQueries = true;
+                } else if (val == "false" || val == "0") {
+                    opts.occlusionQueries = false;
+                } else {
+                    std::cerr << "Invalid value for --occlusion_queries; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --occlusion_queries\n";
+            }
         } else if (isFlag(a, "--moon_model_path", "--moon_model")) {
             if (i + 1 < args.size()) {
                 opts.moonModelPath = args[++i];
@@ -285,6 +621,121 @@ CLIOptions parseCli(int argc, char** argv) {
             } else {
                 std::cerr << "Missing value for --bg_fragment_shader_path\n";
             }
+        } else if (isFlag(a, "--batch_vertex_shader_path", "--batch_vs")) {
+            if (i + 1 < args.size()) {
+                opts.batchVertexShaderPath = args[++i];
+            } else {
+                std::cerr << "Missing value for --batch_vertex_shader_path\n";
+            }
+        } else if (isFlag(a, "--occlusion_vertex_shader_path", "--occlusion_vs")) {
+            if (i + 1 < args.size()) {
+                opts.occlusionVertexShaderPath = args[++i];
+            } else {
+                std::cerr << "Missing value for --occlusion_vertex_shader_path\n";
+            }
+        } else if (isFlag(a, "--occlusion_fragment_shader_path", "--occlusion_fs")) {
+            if (i + 1 < args.size()) {
+                opts.occlusionFragmentShaderPath = args[++i];
+            } else {
+                std::cerr << "Missing value for --occlusion_fragment_shader_path\n";
+            }
+        } else if (isFlag(a, "--headless", "--headless")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.headless = true;
+                } else if (val == "false" || val == "0") {
+                    opts.headless = false;
+                } else {
+                    std::cerr << "Invalid value for --headless; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --headless\n";
+            }
+        } else if (isFlag(a, "--headless_frames", "--frames")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.headlessFrames = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --headless_frames\n";
+                }
+            } else {
+                std::cerr << "Missing value for --headless_frames\n";
+            }
+        } else if (isFlag(a, "--headless_output", "--output")) {
+            if (i + 1 < args.size()) {
+                opts.headlessOutput = args[++i];
+            } else {
+                std::cerr << "Missing value for --headless_output\n";
+            }
+        } else if (isFlag(a, "--trace_enabled", "--trace")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.traceEnabled = true;
+                } else if (val == "false" || val == "0") {
+                    opts.traceEnabled = false;
+                } else {
+                    std::cerr << "Invalid value for --trace_enabled; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --trace_enabled\n";
+            }
+        } else if (isFlag(a, "--trace_path", "--trace_path")) {
+            if (i + 1 < args.size()) {
+                opts.tracePath = args[++i];
+            } else {
+                std::cerr << "Missing value for --trace_path\n";
+            }
+        } else if (isFlag(a, "--latency_report", "--latency")) {
+            if (i + 1 < args.size()) {
+                std::string val = args[++i];
+                if (val == "true" || val == "1") {
+                    opts.latencyReport = true;
+                } else if (val == "false" || val == "0") {
+                    opts.latencyReport = false;
+                } else {
+                    std::cerr << "Invalid value for --latency_report; use true/false or 1/0\n";
+                }
+            } else {
+                std::cerr << "Missing value for --latency_report\n";
+            }
+        } else if (isFlag(a, "--bench_iterations", "--iterations")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.benchIterations = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --bench_iterations\n";
+                }
+            } else {
+                std::cerr << "Missing value for --bench_iterations\n";
+            }
+        } else if (isFlag(a, "--bench_warmup", "--warmup")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.benchWarmup = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --bench_warmup\n";
+                }
+            } else {
+                std::cerr << "Missing value for --bench_warmup\n";
+            }
+        } else if (isFlag(a, "--bench_json_path", "--json")) {
+            if (i + 1 < args.size()) {
+                opts.benchJsonPath = args[++i];
+            } else {
+                std::cerr << "Missing value for --bench_json_path\n";
+            }
+        } else if (isFlag(a, "--bench_objects", "--bench_objects")) {
+            if (i + 1 < args.size()) {
+                try {
+                    opts.benchObjects = std::stoi(args[++i]);
+                } catch (...) {
+                    std::cerr << "Invalid integer for --bench_objects\n";
+                }
+            } else {
+                std::cerr << "Missing value for --bench_objects\n";
+            }
         } else if (isFlag(a, "--config_path", "--config")) {
             if (i + 1 < args.size()) {
                 opts.configPath = args[++i];
@@ -305,19 +756,54 @@ void printHelp(const char* prog) {
         << "\n"
         << "Options:\n"
         << "  --webcam_name <string>                    Name of the webcam (default: Webcam)\n"
-        << "  --device_name <string>                    Device name (default: /dev/video0)\n"
+        << "  --device_name <string>                    Device, video file or \"synthetic\" (default: /dev/video0)\n"
         << "  --screen_width <int>                      Screen width (default: 640)\n"
         << "  --screen_height <int>                     Screen height (default: 480)\n"
         << "  --fps <int>                               Frames per second (default: 60)\n"
         << "  --onnx_model_path <string>                Path to ONNX model (default: models/yolo11s_hand.onnx)\n"
         << "  --onnx_input_size <int>                   ONNX model input size (default: 640)\n"
+        << "  --detector_sizes <int,...>                Extra detector input sizes for adaptive resolution (default: none)\n"
+        << "  --detector_budget_ms <float>              Detector time budget driving size changes, 0 = off (default: 0)\n"
+        << "  --int8_model_path <string>                INT8 quantized detector model (default: none)\n"
+        << "  --detector_precision <string>             Detector model to run: fp32 or int8 (default: fp32)\n"
         << "  --apply_smoothing <bool>                  Apply smoothing to hand tracking (default: true)\n"
+        << "  --inference_engine <string>               Detector runtime: opencv or onnxruntime (default: opencv)\n"
+        << "  --ort_intra_op_threads <int>              ONNX Runtime intra-op threads, 0 = default (default: 0)\n"
+        << "  --dnn_backends <string,...>               Candidate DNN backends, fastest matching wins (default: cuda,openvino,cpu)\n"
+        << "  --backend_cache_path <string>             Cache of the chosen backend, empty = none (default: backend_cache.yaml)\n"
+        << "  --dnn_fusion <bool>                       Enable OpenCV DNN layer fusion (default: false)\n"
+        << "  --detector_warmup_runs <int>              Background detector warm-up forwards, 0 = off (default: 3)\n"
+        << "  --nms_mode <string>                       hard, soft_linear or soft_gaussian NMS (default: hard)\n"
+        << "  --nms_iou_threshold <float>               IoU above which detections overlap (default: 0.3)\n"
+        << "  --nms_sigma <float>                       Decay width for soft_gaussian NMS (default: 0.5)\n"
+        << "  --motion_gate <bool>                      Skip the detector on static frames (default: false)\n"
+        << "  --motion_threshold <float>                Mean grey-level change counted as motion (default: 2.0)\n"
+        << "  --motion_max_age <int>                    Run the detector at least every N frames, 0 = never forced (default: 30)\n"
+        << "  --tiled_detection <bool>                  Also detect on full-resolution tiles around tracks/motion (default: false)\n"
+        << "  --tile_size <int>                         Tile side in frame pixels, 0 = detector input size (default: 0)\n"
+        << "  --tile_overlap <float>                    Fraction of a tile shared with its neighbours (default: 0.25)\n"
+        << "  --max_tiles <int>                         Tiles per frame besides the whole frame (default: 4)\n"
+        << "  --tile_motion_threshold <float>           Mean grey-level change that makes a tile active (default: 4.0)\n"
+        << "  --inference_threads <int>                 OpenCV worker threads for inference, 0 = default (default: 0)\n"
+        << "  --capture_cores <list>                    Cores for the capture thread, e.g. 0 or 2-3 (default: unpinned)\n"
+        << "  --inference_cores <list>                  Cores for the inference thread and its workers (default: unpinned)\n"
+        << "  --render_cores <list>                     Cores for the render thread (default: unpinned)\n"
+        << "  --capture_priority <int>                  SCHED_FIFO priority for capture, 0 = unchanged (default: 0)\n"
         << "  --camera_speed <float>                    Camera movement speed (default: 1.0)\n"
         << "  --mouse_sensitivity <float>               Mouse sensitivity (default: 0.1)\n"
         << "  --camera_zoom <float>                     Camera zoom level (default: 45.0)\n"
         << "  --init_position <float,float,float>       Initial camera position (default: 0.0,0.0,3.0)\n"
         << "  --earth_model_path <string>               Path to Earth model (default: models/earth.obj)\n"
         << "  --earth_scale <float>                     Scale of the Earth model (default: 1.0)\n"
+        << "  --compressed_textures <bool>              Prefer <texture>.ktx2 compressed textures (default: true)\n"
+        << "  --texture_streaming <bool>                Decode and upload textures in the background (default: true)\n"
+        << "  --texture_upload_budget_kb <int>          Streamed texture KiB uploaded per frame (default: 4096)\n"
+        << "  --keep_mesh_data <bool>                   Keep mesh vertices/indices in RAM after upload (default: false)\n"
+        << "  --batched_submission <bool>               Draw the scene from one shared buffer, multi-draw indirect (default: true)\n"
+        << "  --draw_order <string>                     Depth order per material: none, front_to_back, back_to_front (default: front_to_back)\n"
+        << "  --frustum_culling <bool>                  Skip meshes outside the view frustum (default: true)\n"
+        << "  --occlusion_culling <bool>                Skip orbiters hidden behind the Earth (default: true)\n"
+        << "  --occlusion_queries <bool>                Also skip orbiters hidden by GPU occlusion queries (default: false)\n"
         << "  --moon_model_path <string>                Path to Moon model (default: models/moon.obj)\n"
         << "  --moon_orbit_radius <float>               Orbit radius of Moon (default: 8.0)\n"
         << "  --moon_orbit_speed_deg <float>            Orbit speed of Moon in degrees per second (default: 10.0)\n"
@@ -331,6 +817,19 @@ void printHelp(const char* prog) {
         << "  --earth_fragment_shader_path <string>     Path to Earth fragment shader (default: shaders/earth_shader.fs)\n"
         << "  --bg_vertex_shader_path <string>          Path to background vertex shader (default: shaders/bg_quad.vs)\n"
         << "  --bg_fragment_shader_path <string>        Path to background fragment shader (default: shaders/bg_quad.fs)\n"
+        << "  --batch_vertex_shader_path <string>       Path to batched-submission vertex shader (default: shaders/batch_shader.vs)\n"
+        << "  --occlusion_vertex_shader_path <string>   Path to occlusion-query vertex shader (default: shaders/occlusion_box.vs)\n"
+        << "  --occlusion_fragment_shader_path <string> Path to occlusion-query fragment shader (default: shaders/occlusion_box.fs)\n"
+        << "  --headless <bool>                         Render offscreen via EGL, no window (default: false)\n"
+        << "  --headless_frames <int>                   Frames to render in headless mode (default: 300)\n"
+        << "  --headless_output <string>                Write final headless frame as PNG (default: none)\n"
+        << "  --trace_enabled <bool>                    Record Chrome trace events; 'T' dumps, exit dumps (default: false)\n"
+        << "  --trace_path <string>                     Chrome trace JSON output path (default: trace.json)\n"
+        << "  --latency_report <bool>                   Report capture->present latency at exit (default: false)\n"
+        << "  --bench_iterations <int>                  Measured frames per benchmark run (default: 500)\n"
+        << "  --bench_warmup <int>                      Unmeasured warm-up frames before a benchmark (default: 30)\n"
+        << "  --bench_json_path <string>                Benchmark JSON report path, empty = stdout (default: bench_pipeline.json)\n"
+        << "  --bench_objects <int>                     Models drawn per frame by MillSceneBench (default: 500)\n"
         << "  --config_path <string>                    Path to configuration file (default: config/config.yaml)\n"
         << "  -h, --help                                Show this help message and exit\n"
         << std::endl;
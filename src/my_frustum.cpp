@@ -0,0 +1,94 @@
+#include <my_frustum.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MY_FRUSTUM_SSE2 1
+#endif
+
+static const size_t LANES = 4;
+
+Frustum Frustum::fromMatrix(const glm::mat4& m) {
+    // Row i of the matrix (glm is column-major)
+    auto row = [&](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+    Frustum f;
+    f.planes[0] = row(3) + row(0);
+    f.planes[1] = row(3) - row(0);
+    f.planes[2] = row(3) + row(1);
+    f.planes[3] = row(3) - row(1);
+    f.planes[4] = row(3) + row(2);
+    f.planes[5] = row(3) - row(2);
+    for (glm::vec4& plane : f.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return f;
+}
+
+void SphereCuller::clear() {
+    count_ = 0;
+    x_.clear(); y_.clear(); z_.clear(); r_.clear();
+}
+
+glm::vec4 transformSphere(const glm::mat4& transform, const glm::vec3& center, float radius) {
+    glm::vec3 c = glm::vec3(transform * glm::vec4(center, 1.0f));
+    float scale2 = std::max({glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+                             glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+                             glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]))});
+    return glm::vec4(c, radius * std::sqrt(scale2));
+}
+
+glm::vec4 transformInnerSphere(const glm::mat4& transform, const glm::vec3& center, float radius) {
+    glm::vec3 c = glm::vec3(transform * glm::vec4(center, 1.0f));
+    float scale2 = std::min({glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+                             glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+                             glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]))});
+    return glm::vec4(c, radius * std::sqrt(scale2));
+}
+
+size_t SphereCuller::push(const glm::mat4& transform, const glm::vec3& center, float radius) {
+    const glm::vec4 sphere = transformSphere(transform, center, radius);
+    x_.push_back(sphere.x);
+    y_.push_back(sphere.y);
+    z_.push_back(sphere.z);
+    r_.push_back(sphere.w);
+    return count_++;
+}
+
+size_t SphereCuller::cull(const Frustum& frustum) {
+    // Padding spheres are tested too; their results are never read
+    const size_t padded = (count_ + LANES - 1) / LANES * LANES;
+    x_.resize(padded); y_.resize(padded); z_.resize(padded); r_.resize(padded);
+    visible_.resize(padded);
+
+#ifdef MY_FRUSTUM_SSE2
+    for (size_t i = 0; i < padded; i += LANES) {
+        const __m128 x = _mm_loadu_ps(&x_[i]);
+        const __m128 y = _mm_loadu_ps(&y_[i]);
+        const __m128 z = _mm_loadu_ps(&z_[i]);
+        const __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&r_[i]));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4& p : frustum.planes) {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.x), x), _mm_mul_ps(_mm_set1_ps(p.y), y)),
+                                  _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.z), z), _mm_set1_ps(p.w)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negR));
+        }
+        const int mask = _mm_movemask_ps(inside);
+        for (size_t k = 0; k < LANES; ++k) {
+            visible_[i + k] = static_cast<uint8_t>((mask >> k) & 1);
+        }
+    }
+#else
+    for (size_t i = 0; i < padded; ++i) {
+        bool inside = true;
+        for (const glm::vec4& p : frustum.planes) {
+            inside = inside && p.x * x_[i] + p.y * y_[i] + p.z * z_[i] + p.w >= -r_[i];
+        }
+        visible_[i] = inside ? 1 : 0;
+    }
+#endif
+
+    x_.resize(count_); y_.resize(count_); z_.resize(count_); r_.resize(count_);
+    return static_cast<size_t>(std::count(visible_.begin(), visible_.begin() + count_, 0));
+}
@@ -0,0 +1,105 @@
+#include <my_gl_state.hpp>
+#include <my_render_stats.hpp>
+
+// Count the call and report whether it has to reach GL
+static bool issue(bool changed) {
+    RenderCounters& counters = frameRenderCounters();
+    if (changed) {
+        ++counters.stateIssued;
+    } else {
+        ++counters.stateElided;
+    }
+    return changed;
+}
+
+void GLStateCache::useProgram(GLuint program) {
+    if (!issue(program_ != program)) return;
+    glUseProgram(program);
+    program_ = program;
+}
+
+void GLStateCache::bindVertexArray(GLuint vao) {
+    if (!issue(vao_ != vao)) return;
+    glBindVertexArray(vao);
+    vao_ = vao;
+    ++frameRenderCounters().vaoBinds;
+}
+
+void GLStateCache::activeTexture(unsigned int unit) {
+    if (!issue(activeUnit_ != unit)) return;
+    glActiveTexture(GL_TEXTURE0 + unit);
+    activeUnit_ = unit;
+}
+
+bool GLStateCache::textureSlot_(unsigned int unit, GLenum target, GLuint*& slot) {
+    if (unit >= MAX_TEXTURE_UNITS) return false;
+    if (target == GL_TEXTURE_2D) {
+        slot = &textures2D_[unit];
+    } else if (target == GL_TEXTURE_BUFFER) {
+        slot = &texturesBuffer_[unit];
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void GLStateCache::bindTexture(unsigned int unit, GLenum target, GLuint texture) {
+    GLuint* slot = nullptr;
+    bool tracked = textureSlot_(unit, target, slot);
+    if (!issue(!tracked || *slot != texture)) return;
+    activeTexture(unit);
+    glBindTexture(target, texture);
+    if (tracked) *slot = texture;
+    ++frameRenderCounters().textureBinds;
+}
+
+void GLStateCache::setCap_(GLenum cap, bool on) {
+    for (auto& known : caps_) {
+        if (known.first != cap) continue;
+        if (!issue(known.second != on)) return;
+        known.second = on;
+        if (on) glEnable(cap); else glDisable(cap);
+        return;
+    }
+    issue(true);
+    caps_.push_back({cap, on});
+    if (on) glEnable(cap); else glDisable(cap);
+}
+
+void GLStateCache::enable(GLenum cap) {
+    setCap_(cap, true);
+}
+
+void GLStateCache::disable(GLenum cap) {
+    setCap_(cap, false);
+}
+
+// GL unbinds a deleted object from every unit; the shadow must agree
+void GLStateCache::deleteTexture(GLuint texture) {
+    glDeleteTextures(1, &texture);
+    for (unsigned int unit = 0; unit < MAX_TEXTURE_UNITS; ++unit) {
+        if (textures2D_[unit] == texture) textures2D_[unit] = 0;
+        if (texturesBuffer_[unit] == texture) texturesBuffer_[unit] = 0;
+    }
+}
+
+void GLStateCache::deleteVertexArray(GLuint vao) {
+    glDeleteVertexArrays(1, &vao);
+    if (vao_ == vao) vao_ = 0;
+}
+
+void GLStateCache::invalidate() {
+    program_ = UNKNOWN;
+    vao_ = UNKNOWN;
+    activeUnit_ = UNKNOWN;
+    for (unsigned int unit = 0; unit < MAX_TEXTURE_UNITS; ++unit) {
+        textures2D_[unit] = UNKNOWN;
+        texturesBuffer_[unit] = UNKNOWN;
+    }
+    caps_.clear();
+}
+
+GLStateCache& glState() {
+    static GLStateCache state;
+    return state;
+}
@@ -1,21 +1,113 @@
 #include <my_hands.hpp>
+#include <my_cli.hpp>
+#include <my_threads.hpp>
+#include <my_timing.hpp>
+#include <my_trace.hpp>
+
+#include <opencv2/core/cuda.hpp>
+
+HandTracker::~HandTracker() {
+    waitForWarmup_();
+}
+
+void HandTracker::startWarmup(unsigned int runs, const std::vector<int>& cores) {
+    waitForWarmup_();
+    if (runs == 0 || !loaded_()) return;
+    warmupThread_ = std::thread(&HandTracker::warmup_, this, runs, cores);
+}
+
+void HandTracker::warmup_(unsigned int runs, std::vector<int> cores) {
+    Tracer::setThreadName("warmup");
+    MY_TRACE_SCOPE("HandTracker::warmup");
+    // Stay off the capture and render cores, and create any worker pool on the inference ones
+    std::string pinErr;
+    if (!pinCurrentThread(cores, pinErr)) {
+        std::cerr << "HandTracker: warm-up affinity: " << pinErr << std::endl;
+    }
+    auto warmupStart = SteadyClock::now();
+    // Mid-grey frame through the real preprocessing, so the input buffers get allocated too
+    const cv::Mat frame(detSize_, detSize_, CV_8UC3, cv::Scalar(114, 114, 114));
+    try {
+        for (unsigned int i = 0; i < runs; ++i) {
+            auto forwardStart = SteadyClock::now();
+            cv::Mat& blob = ortNet_ ? ortNet_->inputBlob() : blob_;
+            makeInputBlob(frame, detSize_, blob);
+            cv::Mat output;
+            if (ortNet_) {
+                std::string ortErr;
+                if (!ortNet_->run(output, ortErr)) {
+                    std::cerr << "HandTracker: warm-up failed: " << ortErr << std::endl;
+                    break;
+                }
+            } else {
+                detNet_.setInput(blob);
+                output = detNet_.forward();
+            }
+            if (i == 0) coldForwardMs_ = elapsedMs(forwardStart, SteadyClock::now());
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "HandTracker: warm-up failed: " << e.what() << std::endl;
+    }
+    warmupMs_ = elapsedMs(warmupStart, SteadyClock::now());
+    std::cout << "HandTracker: warm-up of " << runs << " forward(s) took " << warmupMs_
+        << " ms (first " << coldForwardMs_ << " ms)" << std::endl;
+}
+
+// A failing run fails every frame: log the first failure, then one line per ORT_FAILURE_LOG_EVERY
+static const uint64_t ORT_FAILURE_LOG_EVERY = 300;
+
+bool HandTracker::runOrt_(cv::Mat& output) {
+    std::string ortErr;
+    if (ortNet_->run(output, ortErr)) {
+        if (ortFailures_ > 0) {
+            std::cerr << "HandTracker: ONNX Runtime recovered after " << ortFailures_ << " failed run(s)" << std::endl;
+            ortFailures_ = 0;
+        }
+        return true;
+    }
+    if (ortFailures_++ % ORT_FAILURE_LOG_EVERY == 0) {
+        std::cerr << "HandTracker: " << ortErr << " (" << ortFailures_ << " consecutive failure(s))" << std::endl;
+    }
+    return false;
+}
+
+double HandTracker::waitForWarmup_() {
+    if (!warmupThread_.joinable()) return 0.0;
+    auto waitStart = SteadyClock::now();
+    warmupThread_.join();
+    return elapsedMs(waitStart, SteadyClock::now());
+}
 
 bool HandTracker::load(const std::string& detectorOnnxPath,
                        int detectorInput,
                        bool applySmoothing,
                        std::string& err) {
+    waitForWarmup_();
+    detSize_ = detectorInput > 0 ? detectorInput : 640;
+    applySmoothing_ = applySmoothing;
+    modelPath_ = detectorOnnxPath;
+
+    if (engine_ == ENGINE_ONNXRUNTIME) {
+        ortNet_ = std::make_unique<OrtDetector>();
+        if (!ortNet_->load(detectorOnnxPath, detSize_, ortThreads_, err)) {
+            ortNet_.reset();
+            return false;
+        }
+        backendName_ = "onnxruntime_cpu";
+        std::cout << "Loaded detector network (ONNX Runtime) from: " << detectorOnnxPath << std::endl;
+        return true;
+    }
+
     try {
         // Hand detection network
         detNet_ = cv::dnn::readNet(detectorOnnxPath);
-        detNet_.enableFusion(false); // OpenCV was throwing errors in the model fusion function
+        detNet_.enableFusion(fusion_); // off by default: OpenCV was throwing errors in the model fusion function
         if (detNet_.empty()) {
             std::cerr << "Failed to load detector network from: " << detectorOnnxPath << std::endl;
             return false;
         } else {
             std::cout << "Loaded detector network from: " << detectorOnnxPath << std::endl;
         }
-        detSize_ = detectorInput > 0 ? detectorInput : 640;
-        applySmoothing_ = applySmoothing;
         return true;
     } catch (const std::exception& e) {
         err = e.what();
@@ -24,92 +116,320 @@ bool HandTracker::load(const std::string& detectorOnnxPath,
 }
 
 void HandTracker::setBackendTarget(int backend, int target) {
+    waitForWarmup_();
+    backend_ = backend;
+    target_ = target;
     if (!detNet_.empty()) { 
         detNet_.setPreferableBackend(backend); 
         detNet_.setPreferableTarget(target); 
     }
+    for (auto& net : sizeNets_) {
+        if (!net.dnn.empty()) {
+            net.dnn.setPreferableBackend(backend);
+            net.dnn.setPreferableTarget(target);
+        }
+    }
 }
 
-std::vector<HandResult> HandTracker::runPalmDetector_(const cv::Mat& frameBGR) {
-    std::vector<HandResult> results;
-    if (frameBGR.empty() || detNet_.empty()) return results;
+void HandTracker::setFusion(bool enabled) {
+    waitForWarmup_();
+    fusion_ = enabled;
+    if (!detNet_.empty()) {
+        detNet_.enableFusion(enabled);
+    }
+    for (auto& net : sizeNets_) {
+        if (!net.dnn.empty()) {
+            net.dnn.enableFusion(enabled);
+        }
+    }
+}
+
+bool HandTracker::setAdaptiveSizes(const std::vector<int>& sizes, double budgetMs, std::string& err) {
+    waitForWarmup_();
+    if (!loaded_()) {
+        err = "Detector network not loaded";
+        return false;
+    }
+    sizeNets_.clear();
+    budgetMs_ = budgetMs;
+    for (int size : sizes) {
+        bool duplicate = size == detSize_;
+        for (const auto& net : sizeNets_) duplicate = duplicate || net.inputSize == size;
+        if (size <= 0 || size % 32 != 0 || duplicate) continue; // YOLO strides need multiples of 32
+
+        DetectorNet net;
+        net.inputSize = size;
+        std::string netErr;
+        try {
+            if (ortNet_) {
+                net.ort = std::make_unique<OrtDetector>();
+                if (!net.ort->load(modelPath_, size, ortThreads_, netErr)) {
+                    std::cerr << "HandTracker: input " << size << " rejected: " << netErr << std::endl;
+                    continue;
+                }
+            } else {
+                // Own net per size: each keeps its allocations, so switching costs nothing
+                net.dnn = cv::dnn::readNet(modelPath_);
+                net.dnn.enableFusion(fusion_);
+                net.dnn.setPreferableBackend(backend_);
+                net.dnn.setPreferableTarget(target_);
+                const int dims[4] = {1, 3, size, size};
+                net.blob.create(4, dims, CV_32F);
+                net.blob.setTo(0);
+                net.dnn.setInput(net.blob);
+                cv::Mat output = net.dnn.forward();
+                if (output.dims != 3 || output.size[1] != 5) {
+                    std::cerr << "HandTracker: input " << size << " rejected: unexpected output shape" << std::endl;
+                    continue;
+                }
+            }
+        } catch (const cv::Exception& e) {
+            std::cerr << "HandTracker: input " << size << " rejected (fixed-shape model?): " << e.what() << std::endl;
+            continue;
+        }
+        std::cout << "HandTracker: preloaded detector input " << size << std::endl;
+        sizeNets_.push_back(std::move(net));
+    }
+    detectorEmaMs_ = 0.0;
+    confidenceEma_ = 1.0f;
+    framesSinceSwitch_ = 0;
+    return true;
+}
+
+void HandTracker::switchInputSize_(size_t netIndex, const char* reason) {
+    DetectorNet& net = sizeNets_[netIndex];
+    std::cout << "HandTracker: detector input " << detSize_ << " -> " << net.inputSize << " ("
+        << reason << ", detector " << detectorEmaMs_ << " ms, budget " << budgetMs_ << " ms, confidence "
+        << confidenceEma_ << ")" << std::endl;
+
+    // Predict the new cost from the pixel count so the next decision is not made on stale data
+    const double scale = static_cast<double>(net.inputSize) / detSize_;
+    detectorEmaMs_ *= scale * scale;
+    std::swap(detSize_, net.inputSize);
+    std::swap(detNet_, net.dnn);
+    std::swap(ortNet_, net.ort);
+    std::swap(blob_, net.blob);
+    framesSinceSwitch_ = 0;
+}
 
+void HandTracker::adaptInputSize_(const std::vector<HandResult>& detections) {
+    if (budgetMs_ <= 0.0 || sizeNets_.empty()) return;
+
+    const double alpha = 0.2;
+    const double detectorMs = timings_.preprocessMs + timings_.forwardMs + timings_.postprocessMs;
+    detectorEmaMs_ = detectorEmaMs_ > 0.0 ? alpha * detectorMs + (1.0 - alpha) * detectorEmaMs_ : detectorMs;
+    if (!detections.empty()) {
+        float top = 0.0f;
+        for (const auto& d : detections) top = std::max(top, d.score);
+        confidenceEma_ = static_cast<float>(alpha * top + (1.0 - alpha) * confidenceEma_);
+    }
+
+    // Let the average settle between switches so the controller does not oscillate
+    const unsigned int minFramesBetweenSwitches = 30;
+    if (++framesSinceSwitch_ < minFramesBetweenSwitches) return;
+
+    int smaller = -1, larger = -1;
+    for (size_t i = 0; i < sizeNets_.size(); ++i) {
+        int size = sizeNets_[i].inputSize;
+        if (size < detSize_ && (smaller < 0 || size > sizeNets_[smaller].inputSize)) smaller = static_cast<int>(i);
+        if (size > detSize_ && (larger < 0 || size < sizeNets_[larger].inputSize)) larger = static_cast<int>(i);
+    }
+
+    if (detectorEmaMs_ > budgetMs_ && smaller >= 0) {
+        switchInputSize_(smaller, "over budget");
+        return;
+    }
+    if (larger >= 0) {
+        const double scale = static_cast<double>(sizeNets_[larger].inputSize) / detSize_;
+        const double predictedMs = detectorEmaMs_ * scale * scale;
+        const float lowConfidence = confidenceThreshold_ + 0.05f;
+        if (predictedMs < 0.8 * budgetMs_) {
+            switchInputSize_(larger, "headroom");
+        } else if (confidenceEma_ < lowConfidence && predictedMs < budgetMs_) {
+            switchInputSize_(larger, "low confidence");
+        }
+    }
+}
+
+static bool targetAvailable(const BackendCandidate& candidate) {
+    if (candidate.backend == cv::dnn::DNN_BACKEND_CUDA && cv::cuda::getCudaEnabledDeviceCount() <= 0) {
+        return false;
+    }
+    std::vector<cv::dnn::Target> targets =
+        cv::dnn::getAvailableTargets(static_cast<cv::dnn::Backend>(candidate.backend));
+    return std::find(targets.begin(), targets.end(), candidate.target) != targets.end();
+}
+
+bool HandTracker::selectBackend(const std::vector<BackendCandidate>& candidates,
+                                const std::string& cachePath,
+                                std::string& err) {
+    waitForWarmup_();
+    if (ortNet_) {
+        std::cout << "HandTracker: ONNX Runtime engine, DNN backend selection skipped" << std::endl;
+        return true;
+    }
+    if (detNet_.empty()) {
+        err = "Detector network not loaded";
+        return false;
+    }
+
+    // Cache key: model contents + machine + everything that changes the answer
+    std::string modelHash;
+    if (!hashFile(modelPath_, modelHash, err)) return false;
+    std::string names;
+    for (const auto& c : candidates) names += c.name + ",";
+    const std::string cacheKey = modelHash + "-" + hashString(backendMachineId() + "|" + names + "|"
+        + std::to_string(detSize_) + "|fusion=" + (fusion_ ? "1" : "0"));
+
+    std::string cachedName;
+    if (loadCachedBackend(cachePath, cacheKey, cachedName)) {
+        for (const auto& c : candidates) {
+            if (c.name == cachedName && targetAvailable(c)) {
+                setBackendTarget(c.backend, c.target);
+                backendName_ = c.name;
+                std::cout << "HandTracker: using DNN backend " << backendName_
+                    << " (cached in " << cachePath << ")" << std::endl;
+                return true;
+            }
+        }
+    }
+
+    // Fixed pseudo-random input so every candidate sees the same tensor
+    cv::Mat image(detSize_, detSize_, CV_8UC3);
+    cv::RNG rng(0x5eed);
+    rng.fill(image, cv::RNG::UNIFORM, 0, 256);
+    cv::Mat blob = cv::dnn::blobFromImage(image, 1.0/255.0, cv::Size(detSize_, detSize_), cv::Scalar(), true, false);
+
+    // Plain OpenCV FP32 on the CPU is the accuracy reference
+    cv::Mat reference;
+    try {
+        setBackendTarget(cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_CPU);
+        detNet_.setInput(blob);
+        reference = detNet_.forward().clone();
+    } catch (const cv::Exception& e) {
+        err = std::string("Reference forward pass failed: ") + e.what();
+        return false;
+    }
+    const double referenceNorm = std::max(cv::norm(reference, cv::NORM_L2), 1e-6);
+
+    const int warmupRuns = 3;
+    const int timedRuns = 5;
+    const double maxRelativeError = 2e-2; // allows FP16 targets
+    const BackendCandidate* best = nullptr;
+    double bestMs = 0.0;
+    std::cout << "HandTracker: benchmarking " << candidates.size() << " DNN backend(s)" << std::endl;
+    for (const auto& c : candidates) {
+        if (!targetAvailable(c)) {
+            std::cout << "  " << c.name << ": not available" << std::endl;
+            continue;
+        }
+        try {
+            setBackendTarget(c.backend, c.target);
+            cv::Mat output;
+            for (int i = 0; i < warmupRuns; ++i) {
+                detNet_.setInput(blob);
+                output = detNet_.forward();
+            }
+            TimingStats forwardStats;
+            for (int i = 0; i < timedRuns; ++i) {
+                auto start = SteadyClock::now();
+                detNet_.setInput(blob);
+                output = detNet_.forward();
+                forwardStats.add(elapsedMs(start, SteadyClock::now()));
+            }
+
+            if (output.size != reference.size) {
+                std::cout << "  " << c.name << ": output shape differs, rejected" << std::endl;
+                continue;
+            }
+            double relativeError = cv::norm(output, reference, cv::NORM_L2) / referenceNorm;
+            double forwardMs = forwardStats.percentile(50.0);
+            bool matches = relativeError <= maxRelativeError;
+            std::cout << "  " << c.name << ": " << forwardMs << " ms/forward, relative error "
+                << relativeError << (matches ? "" : " (rejected)") << std::endl;
+            if (matches && (!best || forwardMs < bestMs)) {
+                best = &c;
+                bestMs = forwardMs;
+            }
+        } catch (const cv::Exception& e) {
+            std::cout << "  " << c.name << ": failed (" << e.what() << ")" << std::endl;
+        }
+    }
+
+    if (!best) {
+        // Nothing usable in the list; the reference configuration always works
+        setBackendTarget(cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_CPU);
+        backendName_ = "cpu";
+        std::cout << "HandTracker: no listed DNN backend usable, falling back to cpu" << std::endl;
+        return true;
+    }
+
+    setBackendTarget(best->backend, best->target);
+    backendName_ = best->name;
+    std::cout << "HandTracker: using DNN backend " << backendName_ << " (" << bestMs << " ms/forward)" << std::endl;
+
+    std::string cacheErr;
+    if (!storeCachedBackend(cachePath, cacheKey, backendName_, bestMs, cacheErr)) {
+        std::cerr << "Warning: " << cacheErr << std::endl;
+    }
+    return true;
+}
+
+Letterbox HandTracker::makeInputBlob(const cv::Mat& frameBGR, int inputSize, cv::Mat& blob) {
+    cv::Mat input;
+    Letterbox letterbox = letterboxFrame(frameBGR, inputSize, input);
+    cv::dnn::blobFromImage(input, blob, 1.0/255.0, cv::Size(inputSize, inputSize), cv::Scalar(), true, false);
+    return letterbox;
+}
+
+Letterbox HandTracker::letterboxFrame(const cv::Mat& frameBGR, int inputSize, cv::Mat& input) {
     // Let DNN handle aspect: letterbox to square
-    int inWidth = detSize_, inHeight = detSize_;
-    float ratio = std::min((float)inWidth / frameBGR.cols, (float)inHeight / frameBGR.rows);
-    int newWidth = std::round(frameBGR.cols * ratio);
-    int newHeight = std::round(frameBGR.rows * ratio);
+    Letterbox letterbox;
+    int inWidth = inputSize, inHeight = inputSize;
+    letterbox.ratio = std::min((float)inWidth / frameBGR.cols, (float)inHeight / frameBGR.rows);
+    int newWidth = std::round(frameBGR.cols * letterbox.ratio);
+    int newHeight = std::round(frameBGR.rows * letterbox.ratio);
+    letterbox.padX = (inWidth - newWidth) / 2;
+    letterbox.padY = (inHeight - newHeight) / 2;
     cv::Mat resized; cv::resize(frameBGR, resized, cv::Size(newWidth, newHeight));
-    cv::Mat input(inHeight, inWidth, frameBGR.type(), cv::Scalar(114,114,114)); // YOLO common pad value
-    resized.copyTo(input(cv::Rect((inWidth-newWidth)/2, (inHeight-newHeight)/2, newWidth, newHeight)));
+    input.create(inHeight, inWidth, frameBGR.type());
+    input.setTo(cv::Scalar(114,114,114)); // YOLO common pad value
+    resized.copyTo(input(cv::Rect(letterbox.padX, letterbox.padY, newWidth, newHeight)));
+    return letterbox;
+}
+
+std::vector<HandResult> HandTracker::runPalmDetector_(const cv::Mat& frameBGR) {
+    std::vector<HandResult> results;
+    timings_ = HandTimings();
+    if (frameBGR.empty() || !loaded_()) return results;
 
+    auto stageStart = SteadyClock::now();
     try {
-        cv::Mat blob = cv::dnn::blobFromImage(input, 1.0/255.0, cv::Size(inWidth, inHeight), cv::Scalar(), true, false);
-        detNet_.setInput(blob);
-        cv::Mat output = detNet_.forward();
-        CV_Assert(output.dims == 3 && output.size[0] == 1);
+        // ONNX Runtime reads straight from its bound input tensor
+        cv::Mat& blob = ortNet_ ? ortNet_->inputBlob() : blob_;
+        Letterbox letterbox = makeInputBlob(frameBGR, detSize_, blob);
+        auto stageEnd = SteadyClock::now();
+        timings_.preprocessMs = elapsedMs(stageStart, stageEnd);
+        traceSpan("HandTracker::preprocess", stageStart, stageEnd);
 
-        int channels = output.size[1];      // 5
-        int anchorCount = output.size[2]; // 8400
-        CV_Assert(channels == 5);
-
-        cv::Mat channelData(channels, anchorCount, CV_32F, output.ptr<float>());   // (5,8400)
-        cv::Mat predictions; 
-        cv::transpose(channelData, predictions);                           // (8400,5) rows = candidates
-
-        // Letterbox params from your preprocessing
-        int paddingX = (inWidth - std::round(frameBGR.cols * ratio)) / 2;
-        int paddingY = (inHeight - std::round(frameBGR.rows * ratio)) / 2;
-
-        const float nmsThreshold = 0.3f;
-        const float confidenceThreshold = 0.8f;
-        std::vector<cv::Rect> boundingBoxes;
-        std::vector<float> confidenceScores;
-        for (int i = 0; i < predictions.rows; ++i) {
-            const float* row = predictions.ptr<float>(i); // x,y,w,h,conf
-            float confidence = row[4];
-            if (confidence < confidenceThreshold) continue;
-
-            float centerX = row[0];
-            float centerY = row[1];
-            float width  = row[2];
-            float height  = row[3];
-
-            float x1 = centerX - 0.5f * width;
-            float y1 = centerY - 0.5f * height;
-
-            // Remove padding
-            x1 -= paddingX; 
-            y1 -= paddingY;
-            // Scale back
-            x1 /= ratio; 
-            y1 /= ratio;
-            width /= ratio; 
-            height /= ratio;
-
-            cv::Rect boundingBox(
-                (int)std::round(x1),
-                (int)std::round(y1),
-                (int)std::round(width),
-                (int)std::round(height)
-            );
-            boundingBox &= cv::Rect(0,0,frameBGR.cols, frameBGR.rows);
-            if (boundingBox.area() <= 0) continue;
-
-            boundingBoxes.push_back(boundingBox);
-            confidenceScores.push_back(confidence);
-            results.push_back({boundingBox, confidence});
-        }
-
-        // NMS
-        std::vector<int> keepIndices;
-        cv::dnn::NMSBoxes(boundingBoxes, confidenceScores, confidenceThreshold, nmsThreshold, keepIndices);
-
-        // Filter results based on NMS
-        std::vector<HandResult> filteredResults;
-        for (int k : keepIndices) {
-            filteredResults.push_back(results[k]);
+        stageStart = SteadyClock::now();
+        cv::Mat output;
+        if (ortNet_) {
+            if (!runOrt_(output)) return results;
+        } else {
+            detNet_.setInput(blob);
+            output = detNet_.forward();
         }
+        stageEnd = SteadyClock::now();
+        timings_.forwardMs = elapsedMs(stageStart, stageEnd);
+        traceSpan("HandTracker::forward", stageStart, stageEnd);
+
+        stageStart = SteadyClock::now();
+        CV_Assert(output.dims == 3 && output.size[0] == 1);
+        std::vector<HandResult> filteredResults = decodeDetections_(output, 0, letterbox, frameBGR.size());
+        stageEnd = SteadyClock::now();
+        timings_.postprocessMs = elapsedMs(stageStart, stageEnd);
+        traceSpan("HandTracker::postprocess", stageStart, stageEnd);
 
         return filteredResults;
     } catch (const cv::Exception& e) {
@@ -118,14 +438,282 @@ std::vector<HandResult> HandTracker::runPalmDetector_(const cv::Mat& frameBGR) {
     return results;
 }
 
+std::vector<HandResult> HandTracker::decodeDetections_(const cv::Mat& output, int batchIndex,
+                                                       const Letterbox& letterbox, cv::Size frameSize) {
+    candidates_.clear();
+    collectCandidates_(output, batchIndex, letterbox, cv::Rect(cv::Point(), frameSize), frameSize);
+    return suppressCandidates_();
+}
+
+void HandTracker::collectCandidates_(const cv::Mat& output, int batchIndex, const Letterbox& letterbox,
+                                     const cv::Rect& region, cv::Size frameSize) {
+    int channels = output.size[1];      // 5
+    int anchorCount = output.size[2]; // 8400
+    CV_Assert(channels == 5);
+    const float ratio = letterbox.ratio;
+
+    // Output is already channel-major (5,8400): read each channel row directly
+    const float* centerXs = output.ptr<float>(batchIndex);
+    const float* centerYs = centerXs + anchorCount;
+    const float* widths = centerYs + anchorCount;
+    const float* heights = widths + anchorCount;
+    const float* confidences = heights + anchorCount;
+
+    // Letterbox params from preprocessing
+    const int paddingX = letterbox.padX;
+    const int paddingY = letterbox.padY;
+
+    // A tile only sees part of a hand cut by its inner edges; a neighbouring tile
+    // (they overlap) or the whole-frame pass sees all of it
+    const int edge = 2;
+    const bool cutLeft = region.x > 0;
+    const bool cutTop = region.y > 0;
+    const bool cutRight = region.x + region.width < frameSize.width;
+    const bool cutBottom = region.y + region.height < frameSize.height;
+
+    for (int i = 0; i < anchorCount; ++i) {
+        float confidence = confidences[i];
+        if (confidence < confidenceThreshold_) continue;
+
+        float centerX = centerXs[i];
+        float centerY = centerYs[i];
+        float width  = widths[i];
+        float height  = heights[i];
+
+        float x1 = centerX - 0.5f * width;
+        float y1 = centerY - 0.5f * height;
+
+        // Remove padding
+        x1 -= paddingX; 
+        y1 -= paddingY;
+        // Scale back
+        x1 /= ratio; 
+        y1 /= ratio;
+        width /= ratio; 
+        height /= ratio;
+
+        cv::Rect boundingBox(
+            (int)std::round(x1),
+            (int)std::round(y1),
+            (int)std::round(width),
+            (int)std::round(height)
+        );
+        boundingBox &= cv::Rect(0, 0, region.width, region.height);
+        if (boundingBox.area() <= 0) continue;
+        if ((cutLeft && boundingBox.x < edge) || (cutTop && boundingBox.y < edge)
+            || (cutRight && boundingBox.x + boundingBox.width > region.width - edge)
+            || (cutBottom && boundingBox.y + boundingBox.height > region.height - edge)) {
+            continue;
+        }
+        boundingBox += region.tl();
+
+        candidates_.push(boundingBox.x, boundingBox.y, boundingBox.x + boundingBox.width,
+                         boundingBox.y + boundingBox.height, confidence);
+    }
+}
+
+std::vector<HandResult> HandTracker::suppressCandidates_() {
+    // NMS (candidates already passed the confidence threshold)
+    nms_.run(candidates_, nmsParams_, keepIndices_, keptScores_);
+
+    // Filter results based on NMS
+    std::vector<HandResult> filteredResults;
+    filteredResults.reserve(keepIndices_.size());
+    for (size_t k = 0; k < keepIndices_.size(); ++k) {
+        int c = keepIndices_[k];
+        cv::Rect roi(cv::Point((int)candidates_.x1[c], (int)candidates_.y1[c]),
+                     cv::Point((int)candidates_.x2[c], (int)candidates_.y2[c]));
+        filteredResults.push_back({roi, keptScores_[k]});
+    }
+    return filteredResults;
+}
+
+std::vector<std::vector<HandResult>> HandTracker::inferBatch(const std::vector<cv::Mat>& framesBGR) {
+    MY_TRACE_SCOPE("HandTracker::inferBatch");
+    std::vector<std::vector<HandResult>> results(framesBGR.size());
+    waitForWarmup_();
+    if (framesBGR.empty() || !loaded_()) {
+        timings_ = HandTimings();
+        return results;
+    }
+
+    // ONNX Runtime binds a batch-1 tensor; fixed-batch exports cannot take N either
+    bool anyEmpty = false;
+    for (const auto& frame : framesBGR) anyEmpty = anyEmpty || frame.empty();
+    if (ortNet_ || !batchSupported_ || framesBGR.size() == 1 || anyEmpty) {
+        HandTimings total;
+        for (size_t i = 0; i < framesBGR.size(); ++i) {
+            results[i] = runPalmDetector_(framesBGR[i]);
+            total.preprocessMs += timings_.preprocessMs;
+            total.forwardMs += timings_.forwardMs;
+            total.postprocessMs += timings_.postprocessMs;
+        }
+        timings_ = total;
+        return results;
+    }
+
+    timings_ = HandTimings();
+    const int batch = static_cast<int>(framesBGR.size());
+    try {
+        auto stageStart = SteadyClock::now();
+        batchInputs_.resize(batch);
+        batchLetterboxes_.resize(batch);
+        for (int i = 0; i < batch; ++i) {
+            batchLetterboxes_[i] = letterboxFrame(framesBGR[i], detSize_, batchInputs_[i]);
+        }
+        cv::dnn::blobFromImages(batchInputs_, batchBlob_, 1.0/255.0, cv::Size(detSize_, detSize_), cv::Scalar(), true, false);
+        auto stageEnd = SteadyClock::now();
+        timings_.preprocessMs = elapsedMs(stageStart, stageEnd);
+        traceSpan("HandTracker::preprocess", stageStart, stageEnd);
+
+        stageStart = SteadyClock::now();
+        detNet_.setInput(batchBlob_);
+        cv::Mat output = detNet_.forward();
+        stageEnd = SteadyClock::now();
+        timings_.forwardMs = elapsedMs(stageStart, stageEnd);
+        traceSpan("HandTracker::forward", stageStart, stageEnd);
+        CV_Assert(output.dims == 3 && output.size[0] == batch);
+
+        // Split the (N,5,8400) output back per frame
+        stageStart = SteadyClock::now();
+        for (int i = 0; i < batch; ++i) {
+            results[i] = decodeDetections_(output, i, batchLetterboxes_[i], framesBGR[i].size());
+        }
+        stageEnd = SteadyClock::now();
+        timings_.postprocessMs = elapsedMs(stageStart, stageEnd);
+        traceSpan("HandTracker::postprocess", stageStart, stageEnd);
+    } catch (const cv::Exception& e) {
+        std::cerr << "HandTracker: batched forward failed (fixed batch dimension?), "
+            << "falling back to one frame per forward: " << e.what() << std::endl;
+        batchSupported_ = false;
+        return inferBatch(framesBGR);
+    }
+    return results;
+}
+
+std::vector<HandResult> HandTracker::runTiled_(const cv::Mat& frameBGR) {
+    const int tileSize = tilePlanner_.params().tileSize > 0 ? tilePlanner_.params().tileSize : detSize_;
+    if (!loaded_() || (frameBGR.cols <= tileSize && frameBGR.rows <= tileSize)) {
+        return runPalmDetector_(frameBGR); // one tile would not add resolution
+    }
+
+    std::vector<HandResult> results;
+    timings_ = HandTimings();
+    try {
+        auto stageStart = SteadyClock::now();
+        trackRois_.clear();
+        for (const auto& hand : lastHands_) trackRois_.push_back(hand.roi);
+        tilePlanner_.select(frameBGR, trackRois_, tileSize, tiles_);
+
+        // Input 0 is the whole frame (large, near hands); the others are tiles at full resolution
+        const size_t count = tiles_.size() + 1;
+        tileRegions_.assign(1, cv::Rect(cv::Point(), frameBGR.size()));
+        tileRegions_.insert(tileRegions_.end(), tiles_.begin(), tiles_.end());
+        batchInputs_.resize(count);
+        batchLetterboxes_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            batchLetterboxes_[i] = letterboxFrame(frameBGR(tileRegions_[i]), detSize_, batchInputs_[i]);
+        }
+        auto stageEnd = SteadyClock::now();
+        timings_.preprocessMs = elapsedMs(stageStart, stageEnd);
+        traceSpan("HandTracker::preprocess", stageStart, stageEnd);
+
+        candidates_.clear();
+        bool batched = false;
+        if (batchSupported_ && !ortNet_ && count > 1) {
+            try {
+                stageStart = SteadyClock::now();
+                cv::dnn::blobFromImages(batchInputs_, batchBlob_, 1.0/255.0, cv::Size(detSize_, detSize_),
+                                        cv::Scalar(), true, false);
+                detNet_.setInput(batchBlob_);
+                cv::Mat output = detNet_.forward();
+                stageEnd = SteadyClock::now();
+                timings_.forwardMs = elapsedMs(stageStart, stageEnd);
+                traceSpan("HandTracker::forward", stageStart, stageEnd);
+                CV_Assert(output.dims == 3 && output.size[0] == static_cast<int>(count));
+
+                stageStart = SteadyClock::now();
+                for (size_t i = 0; i < count; ++i) {
+                    collectCandidates_(output, static_cast<int>(i), batchLetterboxes_[i], tileRegions_[i],
+                                       frameBGR.size());
+                }
+                timings_.postprocessMs = elapsedMs(stageStart, SteadyClock::now());
+                batched = true;
+            } catch (const cv::Exception& e) {
+                std::cerr << "HandTracker: batched tiles failed (fixed batch dimension?), "
+                    << "running one tile per forward: " << e.what() << std::endl;
+                batchSupported_ = false;
+                candidates_.clear();
+                timings_.forwardMs = 0.0;
+            }
+        }
+        if (!batched) {
+            for (size_t i = 0; i < count; ++i) {
+                stageStart = SteadyClock::now();
+                cv::Mat& blob = ortNet_ ? ortNet_->inputBlob() : blob_;
+                cv::dnn::blobFromImage(batchInputs_[i], blob, 1.0/255.0, cv::Size(detSize_, detSize_),
+                                       cv::Scalar(), true, false);
+                cv::Mat output;
+                if (ortNet_) {
+                    if (!runOrt_(output)) return results;
+                } else {
+                    detNet_.setInput(blob);
+                    output = detNet_.forward();
+                }
+                stageEnd = SteadyClock::now();
+                timings_.forwardMs += elapsedMs(stageStart, stageEnd);
+                traceSpan("HandTracker::forward", stageStart, stageEnd);
+
+                stageStart = SteadyClock::now();
+                CV_Assert(output.dims == 3 && output.size[0] == 1);
+                collectCandidates_(output, 0, batchLetterboxes_[i], tileRegions_[i], frameBGR.size());
+                timings_.postprocessMs += elapsedMs(stageStart, SteadyClock::now());
+            }
+        }
+
+        // One NMS over every input merges a hand seen by the frame pass and by tiles
+        stageStart = SteadyClock::now();
+        results = suppressCandidates_();
+        stageEnd = SteadyClock::now();
+        timings_.postprocessMs += elapsedMs(stageStart, stageEnd);
+        traceSpan("HandTracker::postprocess", stageStart, stageEnd);
+    } catch (const cv::Exception& e) {
+        std::cerr << "OpenCV Exception: " << e.what() << std::endl;
+    }
+    return results;
+}
+
 std::vector<HandResult> HandTracker::infer(const cv::Mat& frameBGR) {
+    MY_TRACE_SCOPE("HandTracker::infer");
     std::vector<HandResult> hands;
     if (frameBGR.empty()) {
         return hands;
     }
 
-    // Run inference on every frame
-    auto handResults = runPalmDetector_(frameBGR);
+    // Static scene: reuse the previous hands instead of running the network
+    auto gateStart = SteadyClock::now();
+    bool runDetector = motionGate_.shouldRun(frameBGR);
+    auto gateEnd = SteadyClock::now();
+    if (!runDetector) {
+        traceSpan("HandTracker::motionGate", gateStart, gateEnd);
+        timings_ = HandTimings();
+        timings_.motionMs = elapsedMs(gateStart, gateEnd);
+        timings_.skipped = true;
+        return lastHands_;
+    }
+
+    const double warmupWaitMs = waitForWarmup_();
+    auto handResults = tilePlanner_.enabled() ? runTiled_(frameBGR) : runPalmDetector_(frameBGR);
+    if (firstInferenceMs_ < 0.0) {
+        firstInferenceMs_ = warmupWaitMs + timings_.preprocessMs + timings_.forwardMs + timings_.postprocessMs;
+        std::cout << "HandTracker: first inference took " << firstInferenceMs_ << " ms (forward "
+            << timings_.forwardMs << " ms, waited " << warmupWaitMs << " ms for warm-up)" << std::endl;
+    }
+    adaptInputSize_(handResults);
+    if (motionGate_.enabled()) {
+        traceSpan("HandTracker::motionGate", gateStart, gateEnd);
+        timings_.motionMs = elapsedMs(gateStart, gateEnd);
+    }
 
     if (applySmoothing_) {
         // Smooth between consecutive frames
@@ -152,5 +740,84 @@ std::vector<HandResult> HandTracker::infer(const cv::Mat& frameBGR) {
         hands = handResults; // No smoothing; use raw results
     }
 
+    lastHands_ = hands;
+
     return hands;
 }
+
+// Everything configureHandTracker() does on the inference cores
+static bool applyDetectorOptions(HandTracker& tracker, const CLIOptions& options,
+                                 const std::vector<int>& inferenceCores, std::string& err) {
+    std::string warnErr;
+    InferenceEngine engine = ENGINE_OPENCV_DNN;
+    if (!parseInferenceEngine(options.inferenceEngine, engine)) {
+        std::cerr << "Warning: unknown inference_engine '" << options.inferenceEngine << "', using opencv" << std::endl;
+    }
+    // One thread budget for both runtimes unless ONNX Runtime is given its own
+    if (options.inferenceThreads > 0) {
+        cv::setNumThreads(static_cast<int>(options.inferenceThreads));
+    }
+    unsigned int ortThreads = options.ortIntraOpThreads > 0 ? options.ortIntraOpThreads : options.inferenceThreads;
+    tracker.setEngine(engine, static_cast<int>(ortThreads));
+    tracker.setFusion(options.dnnFusion);
+    if (options.detectorPrecision == "int8" && options.int8ModelPath.empty()) {
+        std::cerr << "Warning: detector_precision is int8 but int8_model_path is empty, using the FP32 model" << std::endl;
+    }
+    if (!tracker.load(options.detectorModelPath(), options.onnxInputSize, options.applySmoothing, err)) {
+        return false;
+    }
+
+    // Pick the fastest backend that reproduces the CPU result
+    std::vector<BackendCandidate> backends;
+    if (!parseBackendList(options.dnnBackends, backends, warnErr)
+        || !tracker.selectBackend(backends, options.backendCachePath, warnErr)) {
+        std::cerr << "Warning: backend selection failed: " << warnErr << " (using OpenCV defaults)" << std::endl;
+    }
+
+    // Adaptive input resolution
+    if (options.detectorBudgetMs > 0.0f && !options.detectorSizes.empty()
+        && !tracker.setAdaptiveSizes(options.detectorSizeList(), options.detectorBudgetMs, warnErr)) {
+        std::cerr << "Warning: adaptive detector sizes disabled: " << warnErr << std::endl;
+    }
+
+    NmsParams nmsParams;
+    if (!parseNmsMode(options.nmsMode, nmsParams.mode)) {
+        std::cerr << "Warning: unknown nms_mode '" << options.nmsMode << "', using hard" << std::endl;
+    }
+    nmsParams.iouThreshold = options.nmsIouThreshold;
+    nmsParams.sigma = options.nmsSigma;
+    tracker.setNmsParams(nmsParams);
+    tracker.setMotionGate(options.motionGate, options.motionThreshold, options.motionMaxAge);
+    TilingParams tiling;
+    tiling.enabled = options.tiledDetection;
+    tiling.tileSize = static_cast<int>(options.tileSize);
+    tiling.overlap = options.tileOverlap;
+    tiling.maxTiles = options.maxTiles;
+    tiling.motionThreshold = options.tileMotionThreshold;
+    tracker.setTiling(tiling);
+
+    // Warm the detector up in the background while the caller loads everything else
+    tracker.startWarmup(options.detectorWarmupRuns, inferenceCores);
+    return true;
+}
+
+bool configureHandTracker(HandTracker& tracker, const CLIOptions& options, std::string& err) {
+    std::string warnErr;
+    std::vector<int> inferenceCores, callerCores;
+    if (!parseCoreList(options.inferenceCores, inferenceCores, warnErr)) {
+        std::cerr << "Warning: " << warnErr << " (inference unpinned)" << std::endl;
+        inferenceCores.clear();
+    }
+    // OpenCV's worker pool is created by the first thread to run a parallel forward, which is this one
+    // (backend selection, adaptive sizes), and inherits its mask
+    if (!inferenceCores.empty()
+        && (!currentThreadCores(callerCores, warnErr) || !pinCurrentThread(inferenceCores, warnErr))) {
+        std::cerr << "Warning: inference affinity: " << warnErr << std::endl;
+        callerCores.clear();
+    }
+    const bool loaded = applyDetectorOptions(tracker, options, inferenceCores, err);
+    if (!pinCurrentThread(callerCores, warnErr)) {
+        std::cerr << "Warning: could not restore thread affinity: " << warnErr << std::endl;
+    }
+    return loaded;
+}
@@ -0,0 +1,151 @@
+#include <my_headless.hpp>
+#include <EGL/eglext.h>
+#include <opencv2/imgproc.hpp>
+#include <iostream>
+
+HeadlessContext::HeadlessContext(int width, int height)
+    : width_(width), height_(height), display_(EGL_NO_DISPLAY), surface_(EGL_NO_SURFACE),
+      context_(EGL_NO_CONTEXT), fbo_(0), colorRb_(0), depthRb_(0) {}
+
+HeadlessContext::~HeadlessContext() {
+    if (context_ != EGL_NO_CONTEXT) {
+        glDeleteFramebuffers(1, &fbo_);
+        glDeleteRenderbuffers(1, &colorRb_);
+        glDeleteRenderbuffers(1, &depthRb_);
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display_, context_);
+    }
+    if (surface_ != EGL_NO_SURFACE) {
+        eglDestroySurface(display_, surface_);
+    }
+    if (display_ != EGL_NO_DISPLAY) {
+        eglTerminate(display_);
+    }
+}
+
+bool HeadlessContext::createDisplay_(std::string& errMsg) {
+    EGLint major = 0, minor = 0;
+
+    // Default display first (works with a GPU driver or Mesa on a DRM device)
+    display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display_ != EGL_NO_DISPLAY && eglInitialize(display_, &major, &minor)) {
+        return true;
+    }
+
+    // Surfaceless Mesa platform: no X11/Wayland/DRM needed (llvmpipe)
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        display_ = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display_ != EGL_NO_DISPLAY && eglInitialize(display_, &major, &minor)) {
+            return true;
+        }
+    }
+
+    display_ = EGL_NO_DISPLAY;
+    errMsg = "Could not initialize an EGL display";
+    return false;
+}
+
+bool HeadlessContext::initialize(std::string& errMsg) {
+    if (!createDisplay_(errMsg)) {
+        return false;
+    }
+
+    // Pbuffer-capable config; depth lives in the FBO so the pbuffer can be tiny
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(display_, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+        errMsg = "No EGL config supports desktop OpenGL pbuffers";
+        return false;
+    }
+
+    // Surfaceless displays have no pbuffers; the FBO is all we need anyway
+    const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+    surface_ = eglCreatePbufferSurface(display_, config, pbufferAttribs);
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        errMsg = "eglBindAPI(EGL_OPENGL_API) failed";
+        return false;
+    }
+
+    // Same 3.3 core profile as the windowed path
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context_ == EGL_NO_CONTEXT) {
+        errMsg = "Failed to create an OpenGL 3.3 core EGL context";
+        return false;
+    }
+    if (!eglMakeCurrent(display_, surface_, surface_, context_)) {
+        errMsg = "eglMakeCurrent failed";
+        return false;
+    }
+
+    // Load all OpenGL function pointers with GLAD
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        errMsg = "Failed to initialize GLAD";
+        return false;
+    }
+    std::cout << "Headless renderer: " << glGetString(GL_RENDERER)
+        << " (" << glGetString(GL_VERSION) << ")" << std::endl;
+
+    return createFramebuffer_(errMsg);
+}
+
+bool HeadlessContext::createFramebuffer_(std::string& errMsg) {
+    glGenFramebuffers(1, &fbo_);
+    glGenRenderbuffers(1, &colorRb_);
+    glGenRenderbuffers(1, &depthRb_);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRb_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width_, height_);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRb_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width_, height_);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRb_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRb_);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        errMsg = "Offscreen framebuffer is incomplete";
+        return false;
+    }
+    bindFramebuffer();
+    return true;
+}
+
+void HeadlessContext::bindFramebuffer() {
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glViewport(0, 0, width_, height_);
+}
+
+void HeadlessContext::finish() {
+    glFinish();
+}
+
+bool HeadlessContext::readPixels(cv::Mat& frameBGR) {
+    if (fbo_ == 0) return false;
+
+    cv::Mat rgba(height_, width_, CV_8UC4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width_, height_, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data);
+
+    // GL origin is bottom-left
+    cv::flip(rgba, rgba, 0);
+    cv::cvtColor(rgba, frameBGR, cv::COLOR_RGBA2BGR);
+    return true;
+}
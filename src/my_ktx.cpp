@@ -0,0 +1,206 @@
+#include <my_ktx.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+static const uint8_t KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+static const size_t HEADER_BYTES = 80;      // identifier, header and index
+static const size_t LEVEL_INDEX_BYTES = 24; // byteOffset, byteLength, uncompressedByteLength
+
+// Khronos data format descriptor constants (KHR_DF_*)
+static const uint8_t DF_MODEL_BC1A = 128;
+static const uint8_t DF_MODEL_BC3 = 130;
+static const uint8_t DF_MODEL_ETC2 = 161;
+static const uint8_t DF_CHANNEL_COLOR = 0;
+static const uint8_t DF_CHANNEL_ETC2_COLOR = 2;
+static const uint8_t DF_CHANNEL_ALPHA = 15;
+static const uint8_t DF_PRIMARIES_BT709 = 1;
+static const uint8_t DF_TRANSFER_LINEAR = 1;
+
+static size_t formatBlockBytes(uint32_t vkFormat) {
+    switch (vkFormat) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        return 8;
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+static size_t levelBytes(uint32_t vkFormat, int width, int height) {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * formatBlockBytes(vkFormat);
+}
+
+static void put32(std::string& out, uint32_t v) {
+    for (int b = 0; b < 4; ++b) out.push_back(static_cast<char>((v >> (8 * b)) & 0xff));
+}
+
+static void put64(std::string& out, uint64_t v) {
+    for (int b = 0; b < 8; ++b) out.push_back(static_cast<char>((v >> (8 * b)) & 0xff));
+}
+
+static uint32_t get32(const std::string& in, size_t offset) {
+    uint32_t v = 0;
+    for (int b = 0; b < 4; ++b) v |= static_cast<uint32_t>(static_cast<uint8_t>(in[offset + b])) << (8 * b);
+    return v;
+}
+
+static uint64_t get64(const std::string& in, size_t offset) {
+    return static_cast<uint64_t>(get32(in, offset)) | static_cast<uint64_t>(get32(in, offset + 4)) << 32;
+}
+
+static void padTo(std::string& out, size_t alignment) {
+    while (out.size() % alignment != 0) out.push_back('\0');
+}
+
+// Basic descriptor block: one sample per 64-bit half of the block
+static std::string makeDfd(uint32_t vkFormat) {
+    uint8_t model = DF_MODEL_BC1A;
+    std::vector<uint8_t> channels;
+    switch (vkFormat) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK: channels = {DF_CHANNEL_COLOR}; break;
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: channels = {DF_CHANNEL_ALPHA}; break;
+    case VK_FORMAT_BC3_UNORM_BLOCK: model = DF_MODEL_BC3; channels = {DF_CHANNEL_ALPHA, DF_CHANNEL_COLOR}; break;
+    case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK: model = DF_MODEL_ETC2; channels = {DF_CHANNEL_ETC2_COLOR}; break;
+    default: model = DF_MODEL_ETC2; channels = {DF_CHANNEL_ALPHA, DF_CHANNEL_ETC2_COLOR}; break;
+    }
+    const uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(channels.size());
+
+    std::string dfd;
+    put32(dfd, 4 + blockSize);                  // dfdTotalSize
+    put32(dfd, 0);                              // vendorId KHRONOS, descriptorType BASIC
+    put32(dfd, 2u | blockSize << 16);           // versionNumber 1.3, descriptorBlockSize
+    dfd.push_back(static_cast<char>(model));
+    dfd.push_back(static_cast<char>(DF_PRIMARIES_BT709));
+    dfd.push_back(static_cast<char>(DF_TRANSFER_LINEAR));
+    dfd.push_back(0);                           // flags: straight alpha
+    const char texelBlock[4] = {3, 3, 0, 0};    // 4x4x1x1, stored minus one
+    dfd.append(texelBlock, 4);
+    dfd.push_back(static_cast<char>(formatBlockBytes(vkFormat)));
+    dfd.append(7, '\0');                        // bytesPlane1..7
+    for (size_t s = 0; s < channels.size(); ++s) {
+        put32(dfd, static_cast<uint32_t>(64 * s) | 63u << 16 | static_cast<uint32_t>(channels[s]) << 24);
+        put32(dfd, 0);                          // samplePosition
+        put32(dfd, 0);                          // sampleLower
+        put32(dfd, 0xffffffffu);                // sampleUpper
+    }
+    return dfd;
+}
+
+bool writeKtx2(const std::string& path, const KtxTexture& texture, const std::string& writer, std::string& err) {
+    const size_t blockBytes = formatBlockBytes(texture.vkFormat);
+    if (blockBytes == 0 || texture.levels.empty() || texture.width <= 0 || texture.height <= 0) {
+        err = "Unsupported or empty texture for " + path;
+        return false;
+    }
+    const uint32_t levelCount = static_cast<uint32_t>(texture.levels.size());
+
+    const std::string dfd = makeDfd(texture.vkFormat);
+    std::string kvd;
+    const std::string key = "KTXwriter";
+    put32(kvd, static_cast<uint32_t>(key.size() + 1 + writer.size() + 1));
+    kvd += key;
+    kvd.push_back('\0');
+    kvd += writer;
+    kvd.push_back('\0');
+    padTo(kvd, 4);
+
+    const size_t dfdOffset = HEADER_BYTES + LEVEL_INDEX_BYTES * levelCount;
+    const size_t kvdOffset = dfdOffset + dfd.size();
+
+    // Mip data follows, smallest level first, each aligned to the block size
+    std::vector<uint64_t> offsets(levelCount);
+    size_t cursor = kvdOffset + kvd.size();
+    for (int level = static_cast<int>(levelCount) - 1; level >= 0; --level) {
+        cursor = (cursor + blockBytes - 1) / blockBytes * blockBytes;
+        offsets[level] = cursor;
+        cursor += texture.levels[level].size();
+    }
+
+    std::string out(KTX2_IDENTIFIER, KTX2_IDENTIFIER + sizeof(KTX2_IDENTIFIER));
+    put32(out, texture.vkFormat);
+    put32(out, 1);                              // typeSize
+    put32(out, static_cast<uint32_t>(texture.width));
+    put32(out, static_cast<uint32_t>(texture.height));
+    put32(out, 0);                              // pixelDepth
+    put32(out, 0);                              // layerCount
+    put32(out, 1);                              // faceCount
+    put32(out, levelCount);
+    put32(out, 0);                              // supercompressionScheme
+    put32(out, static_cast<uint32_t>(dfdOffset));
+    put32(out, static_cast<uint32_t>(dfd.size()));
+    put32(out, static_cast<uint32_t>(kvdOffset));
+    put32(out, static_cast<uint32_t>(kvd.size()));
+    put64(out, 0);                              // sgdByteOffset
+    put64(out, 0);                              // sgdByteLength
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        put64(out, offsets[level]);
+        put64(out, texture.levels[level].size());
+        put64(out, texture.levels[level].size());
+    }
+    out += dfd;
+    out += kvd;
+    for (int level = static_cast<int>(levelCount) - 1; level >= 0; --level) {
+        out.resize(offsets[level], '\0');
+        out.append(reinterpret_cast<const char*>(texture.levels[level].data()), texture.levels[level].size());
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file || !file.write(out.data(), out.size())) {
+        err = "Could not write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool readKtx2(const std::string& bytes, KtxTexture& texture, std::string& err) {
+    if (bytes.size() < HEADER_BYTES || std::memcmp(bytes.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        err = "Not a KTX2 file";
+        return false;
+    }
+    texture.vkFormat = get32(bytes, 12);
+    const uint32_t width = get32(bytes, 20);
+    const uint32_t height = get32(bytes, 24);
+    const uint32_t depth = get32(bytes, 28);
+    const uint32_t layers = get32(bytes, 32);
+    const uint32_t faces = get32(bytes, 36);
+    const uint32_t levelCount = get32(bytes, 40);
+    const uint32_t supercompression = get32(bytes, 44);
+    if (formatBlockBytes(texture.vkFormat) == 0) {
+        err = "Unsupported KTX2 vkFormat " + std::to_string(texture.vkFormat);
+        return false;
+    }
+    if (width == 0 || height == 0 || width > 16384 || height > 16384 || depth != 0 || layers != 0 || faces != 1
+        || supercompression != 0 || levelCount == 0 || levelCount > 15) {
+        err = "Unsupported KTX2 layout (only plain 2D textures with stored mips)";
+        return false;
+    }
+    if (bytes.size() < HEADER_BYTES + LEVEL_INDEX_BYTES * levelCount) {
+        err = "Truncated KTX2 level index";
+        return false;
+    }
+
+    texture.width = static_cast<int>(width);
+    texture.height = static_cast<int>(height);
+    texture.levels.assign(levelCount, {});
+    int levelWidth = texture.width, levelHeight = texture.height;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const size_t entry = HEADER_BYTES + LEVEL_INDEX_BYTES * level;
+        const uint64_t offset = get64(bytes, entry);
+        const uint64_t length = get64(bytes, entry + 8);
+        if (length != levelBytes(texture.vkFormat, levelWidth, levelHeight) || offset > bytes.size()
+            || length > bytes.size() - offset) {
+            err = "Bad KTX2 level " + std::to_string(level);
+            return false;
+        }
+        texture.levels[level].assign(bytes.begin() + offset, bytes.begin() + offset + length);
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+    return true;
+}
@@ -0,0 +1,102 @@
+#include <my_latency.hpp>
+
+#include <opencv2/imgproc.hpp>
+
+// Stamp layout: 4 marker blocks (1010), 16 frame id bits, 48 bits of capture time in microseconds
+static const int STAMP_MARKER_BITS = 4;
+static const int STAMP_ID_BITS = 16;
+static const int STAMP_TIME_BITS = 48;
+static const int STAMP_BLOCKS = STAMP_MARKER_BITS + STAMP_ID_BITS + STAMP_TIME_BITS;
+
+static double nsToMs(int64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+void LatencyTracker::record(const FrameStamps& stamps) {
+    if (stamps.captureNs == 0 || stamps.presentNs == 0) return;
+
+    if (stamps.detectNs != 0 && stamps.detectCaptureNs != 0) {
+        captureToDetect_.add(nsToMs(stamps.detectNs - stamps.detectCaptureNs));
+    }
+    if (stamps.drawNs != 0) {
+        captureToDraw_.add(nsToMs(stamps.drawNs - stamps.captureNs));
+    }
+    captureToPresent_.add(nsToMs(stamps.presentNs - stamps.captureNs));
+    if (stamps.detectCaptureNs != 0) {
+        detectionStaleness_.add(nsToMs(stamps.presentNs - stamps.detectCaptureNs));
+    }
+}
+
+void LatencyTracker::recordInference(int64_t captureNs, int64_t detectNs) {
+    if (captureNs == 0 || detectNs == 0) return;
+    inferenceLatency_.add(nsToMs(detectNs - captureNs));
+}
+
+void LatencyTracker::printSummary(std::ostream& os) const {
+    captureToDetect_.printSummary("Latency capture->detect", os);
+    if (inferenceLatency_.count() > 0) {
+        inferenceLatency_.printSummary("Latency capture->detect (every inference)", os);
+    }
+    captureToDraw_.printSummary("Latency capture->draw", os);
+    captureToPresent_.printSummary("Latency capture->present", os);
+    detectionStaleness_.printSummary("Detection staleness at present", os);
+}
+
+void LatencyTracker::writeJson(std::ostream& os) const {
+    os << "{\"capture_to_detect\": ";
+    captureToDetect_.writeJson(os);
+    os << ", \"inference_capture_to_detect\": ";
+    inferenceLatency_.writeJson(os);
+    os << ", \"capture_to_draw\": ";
+    captureToDraw_.writeJson(os);
+    os << ", \"capture_to_present\": ";
+    captureToPresent_.writeJson(os);
+    os << ", \"detection_staleness\": ";
+    detectionStaleness_.writeJson(os);
+    os << "}";
+}
+
+static int stampBlockSize(const cv::Mat& frame) {
+    return frame.cols / STAMP_BLOCKS;
+}
+
+void encodeFrameStamp(cv::Mat& frameBGR, uint16_t frameId, int64_t captureNs) {
+    int bs = stampBlockSize(frameBGR);
+    if (bs < 2 || frameBGR.rows < bs) return;
+
+    uint64_t micros = static_cast<uint64_t>(captureNs / 1000);
+    for (int b = 0; b < STAMP_BLOCKS; ++b) {
+        bool bit;
+        if (b < STAMP_MARKER_BITS) {
+            bit = (b % 2) == 0;
+        } else if (b < STAMP_MARKER_BITS + STAMP_ID_BITS) {
+            bit = (frameId >> (b - STAMP_MARKER_BITS)) & 1u;
+        } else {
+            bit = (micros >> (b - STAMP_MARKER_BITS - STAMP_ID_BITS)) & 1u;
+        }
+        cv::Scalar colour = bit ? cv::Scalar(255, 255, 255) : cv::Scalar(0, 0, 0);
+        cv::rectangle(frameBGR, cv::Rect(b * bs, 0, bs, bs), colour, cv::FILLED);
+    }
+}
+
+bool decodeFrameStamp(const cv::Mat& frameBGR, uint16_t& frameId, int64_t& captureNs) {
+    int bs = stampBlockSize(frameBGR);
+    if (bs < 2 || frameBGR.rows < bs || frameBGR.type() != CV_8UC3) return false;
+
+    // Sample block centres so filtering at block edges does not matter
+    uint64_t id = 0, micros = 0;
+    for (int b = 0; b < STAMP_BLOCKS; ++b) {
+        const cv::Vec3b& px = frameBGR.at<cv::Vec3b>(bs / 2, b * bs + bs / 2);
+        bool bit = (px[0] + px[1] + px[2]) > 3 * 127;
+        if (b < STAMP_MARKER_BITS) {
+            if (bit != ((b % 2) == 0)) return false;
+        } else if (b < STAMP_MARKER_BITS + STAMP_ID_BITS) {
+            id |= static_cast<uint64_t>(bit) << (b - STAMP_MARKER_BITS);
+        } else {
+            micros |= static_cast<uint64_t>(bit) << (b - STAMP_MARKER_BITS - STAMP_ID_BITS);
+        }
+    }
+    frameId = static_cast<uint16_t>(id);
+    captureNs = static_cast<int64_t>(micros) * 1000;
+    return true;
+}
@@ -0,0 +1,11 @@
+#include <my_memory.hpp>
+
+#include <fstream>
+#include <unistd.h>
+
+size_t residentSetBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t sizePages = 0, residentPages = 0;
+    if (!(statm >> sizePages >> residentPages)) return 0;
+    return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
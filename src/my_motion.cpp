@@ -0,0 +1,70 @@
+#include <my_motion.hpp>
+
+#include <opencv2/imgproc.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MY_MOTION_SSE2 1
+#endif
+
+// Thumbnail size: large enough for a hand to move several pixels, small enough to be ~free
+static const int THUMB_WIDTH = 80;
+static const int THUMB_HEIGHT = 60;
+
+void MotionGate::configure(bool enabled, float threshold, unsigned int maxAge) {
+    enabled_ = enabled;
+    threshold_ = threshold;
+    maxAge_ = maxAge;
+    reference_.release();
+    age_ = 0;
+}
+
+bool MotionGate::shouldRun(const cv::Mat& frameBGR) {
+    ++framesSeen_;
+    if (!enabled_ || frameBGR.empty()) return true;
+
+    // Area averaging also filters out sensor noise
+    cv::Mat small;
+    cv::resize(frameBGR, small, cv::Size(THUMB_WIDTH, THUMB_HEIGHT), 0, 0, cv::INTER_AREA);
+    cv::cvtColor(small, thumbnail_, frameBGR.channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY);
+
+    // Compare with what the detector last saw, so slow drift still adds up to a refresh
+    bool run = reference_.empty() || (maxAge_ > 0 && age_ + 1 >= maxAge_);
+    lastEnergy_ = reference_.empty() ? 0.0f : meanAbsDiff(thumbnail_, reference_);
+    run = run || lastEnergy_ > threshold_;
+
+    if (run) {
+        thumbnail_.copyTo(reference_);
+        age_ = 0;
+    } else {
+        ++age_;
+        ++framesSkipped_;
+    }
+    return run;
+}
+
+float meanAbsDiff(const cv::Mat& a, const cv::Mat& b) {
+    CV_Assert(a.type() == CV_8UC1 && b.type() == CV_8UC1 && a.size() == b.size());
+    uint64_t sum = 0;
+    for (int y = 0; y < a.rows; ++y) {
+        const uint8_t* pa = a.ptr<uint8_t>(y);
+        const uint8_t* pb = b.ptr<uint8_t>(y);
+        int x = 0;
+#ifdef MY_MOTION_SSE2
+        // psadbw: 16 absolute differences summed into two 64-bit lanes per instruction
+        __m128i acc = _mm_setzero_si128();
+        for (; x + 16 <= a.cols; x += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pa + x));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pb + x));
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+        }
+        sum += static_cast<uint64_t>(_mm_cvtsi128_si32(acc))
+             + static_cast<uint64_t>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+#endif
+        for (; x < a.cols; ++x) {
+            sum += pa[x] > pb[x] ? pa[x] - pb[x] : pb[x] - pa[x];
+        }
+    }
+    const double pixels = static_cast<double>(a.rows) * a.cols;
+    return pixels > 0 ? static_cast<float>(sum / pixels) : 0.0f;
+}
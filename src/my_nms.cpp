@@ -0,0 +1,195 @@
+#include <my_nms.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MY_NMS_SSE2 1
+#endif
+
+// Score of a candidate removed by hard NMS
+static const float SUPPRESSED = -std::numeric_limits<float>::infinity();
+
+static const size_t LANES = 4;
+
+bool parseNmsMode(const std::string& name, NmsMode& mode) {
+    if (name == "hard") {
+        mode = NMS_HARD;
+    } else if (name == "soft_linear") {
+        mode = NMS_SOFT_LINEAR;
+    } else if (name == "soft_gaussian") {
+        mode = NMS_SOFT_GAUSSIAN;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void BoxNms::sortByScore_(const BoxSoA& boxes) {
+    const size_t count = boxes.size();
+    order_.resize(count);
+    std::iota(order_.begin(), order_.end(), 0);
+    std::stable_sort(order_.begin(), order_.end(),
+                     [&](int a, int b) { return boxes.score[a] > boxes.score[b]; });
+
+    // Gather into sorted order; zero-area padding up to a whole SIMD block never overlaps
+    const size_t padded = (count + LANES - 1) / LANES * LANES;
+    sorted_.x1.assign(padded, 0.0f);
+    sorted_.y1.assign(padded, 0.0f);
+    sorted_.x2.assign(padded, 0.0f);
+    sorted_.y2.assign(padded, 0.0f);
+    sorted_.score.assign(padded, SUPPRESSED);
+    area_.assign(padded, 0.0f);
+    for (size_t i = 0; i < count; ++i) {
+        int k = order_[i];
+        sorted_.x1[i] = boxes.x1[k];
+        sorted_.y1[i] = boxes.y1[k];
+        sorted_.x2[i] = boxes.x2[k];
+        sorted_.y2[i] = boxes.y2[k];
+        sorted_.score[i] = boxes.score[k];
+        area_[i] = std::max(0.0f, boxes.x2[k] - boxes.x1[k]) * std::max(0.0f, boxes.y2[k] - boxes.y1[k]);
+    }
+}
+
+// Intersection of box `kept` with box j (scalar path, also used before the first full block)
+static inline float intersection(const BoxSoA& b, size_t kept, size_t j) {
+    float w = std::min(b.x2[kept], b.x2[j]) - std::max(b.x1[kept], b.x1[j]);
+    float h = std::min(b.y2[kept], b.y2[j]) - std::max(b.y1[kept], b.y1[j]);
+    return std::max(0.0f, w) * std::max(0.0f, h);
+}
+
+void BoxNms::suppressHard_(size_t kept, size_t count, float iouThreshold) {
+    const BoxSoA& b = sorted_;
+    const float keptArea = area_[kept];
+
+    // IoU > t  <=>  inter > t * (areaA + areaB - inter); no division needed
+    size_t j = kept + 1;
+    for (; j < count && j % LANES != 0; ++j) {
+        float inter = intersection(b, kept, j);
+        if (inter > iouThreshold * (keptArea + area_[j] - inter)) {
+            sorted_.score[j] = SUPPRESSED;
+        }
+    }
+
+#ifdef MY_NMS_SSE2
+    const __m128 kx1 = _mm_set1_ps(b.x1[kept]);
+    const __m128 ky1 = _mm_set1_ps(b.y1[kept]);
+    const __m128 kx2 = _mm_set1_ps(b.x2[kept]);
+    const __m128 ky2 = _mm_set1_ps(b.y2[kept]);
+    const __m128 karea = _mm_set1_ps(keptArea);
+    const __m128 thresh = _mm_set1_ps(iouThreshold);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 suppressed = _mm_set1_ps(SUPPRESSED);
+    for (; j < count; j += LANES) {
+        __m128 w = _mm_sub_ps(_mm_min_ps(kx2, _mm_loadu_ps(&b.x2[j])), _mm_max_ps(kx1, _mm_loadu_ps(&b.x1[j])));
+        __m128 h = _mm_sub_ps(_mm_min_ps(ky2, _mm_loadu_ps(&b.y2[j])), _mm_max_ps(ky1, _mm_loadu_ps(&b.y1[j])));
+        __m128 inter = _mm_mul_ps(_mm_max_ps(w, zero), _mm_max_ps(h, zero));
+        __m128 uni = _mm_sub_ps(_mm_add_ps(karea, _mm_loadu_ps(&area_[j])), inter);
+        __m128 overlap = _mm_cmpgt_ps(inter, _mm_mul_ps(thresh, uni));
+        __m128 score = _mm_loadu_ps(&sorted_.score[j]);
+        score = _mm_or_ps(_mm_and_ps(overlap, suppressed), _mm_andnot_ps(overlap, score));
+        _mm_storeu_ps(&sorted_.score[j], score);
+    }
+#else
+    for (; j < count; ++j) {
+        float inter = intersection(b, kept, j);
+        if (inter > iouThreshold * (keptArea + area_[j] - inter)) {
+            sorted_.score[j] = SUPPRESSED;
+        }
+    }
+#endif
+}
+
+void BoxNms::decaySoft_(size_t kept, size_t count, const NmsParams& params) {
+    const BoxSoA& b = sorted_;
+    const float keptArea = area_[kept];
+
+    // IoU against the kept box for every remaining candidate, then rescore
+    size_t j = kept + 1;
+    std::vector<float>& iou = scratchIou_;
+    iou.resize(sorted_.size());
+    for (; j < count && j % LANES != 0; ++j) {
+        float inter = intersection(b, kept, j);
+        float uni = keptArea + area_[j] - inter;
+        iou[j] = uni > 0.0f ? inter / uni : 0.0f;
+    }
+
+#ifdef MY_NMS_SSE2
+    const __m128 kx1 = _mm_set1_ps(b.x1[kept]);
+    const __m128 ky1 = _mm_set1_ps(b.y1[kept]);
+    const __m128 kx2 = _mm_set1_ps(b.x2[kept]);
+    const __m128 ky2 = _mm_set1_ps(b.y2[kept]);
+    const __m128 karea = _mm_set1_ps(keptArea);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 tiny = _mm_set1_ps(std::numeric_limits<float>::min());
+    for (; j < count; j += LANES) {
+        __m128 w = _mm_sub_ps(_mm_min_ps(kx2, _mm_loadu_ps(&b.x2[j])), _mm_max_ps(kx1, _mm_loadu_ps(&b.x1[j])));
+        __m128 h = _mm_sub_ps(_mm_min_ps(ky2, _mm_loadu_ps(&b.y2[j])), _mm_max_ps(ky1, _mm_loadu_ps(&b.y1[j])));
+        __m128 inter = _mm_mul_ps(_mm_max_ps(w, zero), _mm_max_ps(h, zero));
+        __m128 uni = _mm_max_ps(_mm_sub_ps(_mm_add_ps(karea, _mm_loadu_ps(&area_[j])), inter), tiny);
+        _mm_storeu_ps(&iou[j], _mm_div_ps(inter, uni));
+    }
+#else
+    for (; j < count; ++j) {
+        float inter = intersection(b, kept, j);
+        float uni = keptArea + area_[j] - inter;
+        iou[j] = uni > 0.0f ? inter / uni : 0.0f;
+    }
+#endif
+
+    if (params.mode == NMS_SOFT_LINEAR) {
+        for (j = kept + 1; j < count; ++j) {
+            if (iou[j] > params.iouThreshold) sorted_.score[j] *= 1.0f - iou[j];
+        }
+    } else {
+        const float invSigma = 1.0f / std::max(params.sigma, 1e-6f);
+        for (j = kept + 1; j < count; ++j) {
+            if (iou[j] > 0.0f) sorted_.score[j] *= std::exp(-iou[j] * iou[j] * invSigma);
+        }
+    }
+}
+
+void BoxNms::run(const BoxSoA& boxes, const NmsParams& params,
+                 std::vector<int>& keepIndices, std::vector<float>& keptScores) {
+    keepIndices.clear();
+    keptScores.clear();
+    const size_t count = boxes.size();
+    if (count == 0) return;
+
+    sortByScore_(boxes);
+
+    if (params.mode == NMS_HARD) {
+        // Walk in score order; every surviving box is kept and suppresses its overlaps
+        for (size_t i = 0; i < count; ++i) {
+            if (sorted_.score[i] == SUPPRESSED) continue;
+            keepIndices.push_back(order_[i]);
+            keptScores.push_back(sorted_.score[i]);
+            suppressHard_(i, count, params.iouThreshold);
+        }
+        return;
+    }
+
+    // Soft: rescoring reorders the remainder, so pull the best remaining box forward each step
+    for (size_t i = 0; i < count; ++i) {
+        size_t best = i;
+        for (size_t j = i + 1; j < count; ++j) {
+            if (sorted_.score[j] > sorted_.score[best]) best = j;
+        }
+        if (sorted_.score[best] < params.scoreThreshold) break;
+        if (best != i) {
+            std::swap(sorted_.x1[i], sorted_.x1[best]);
+            std::swap(sorted_.y1[i], sorted_.y1[best]);
+            std::swap(sorted_.x2[i], sorted_.x2[best]);
+            std::swap(sorted_.y2[i], sorted_.y2[best]);
+            std::swap(sorted_.score[i], sorted_.score[best]);
+            std::swap(area_[i], area_[best]);
+            std::swap(order_[i], order_[best]);
+        }
+        keepIndices.push_back(order_[i]);
+        keptScores.push_back(sorted_.score[i]);
+        decaySoft_(i, count, params);
+    }
+}
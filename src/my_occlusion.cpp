@@ -0,0 +1,119 @@
+#include <my_occlusion.hpp>
+#include <my_gl_state.hpp>
+#include <my_render_stats.hpp>
+#include <my_trace.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+bool sphereHiddenBySphere(const glm::vec3& eye, const glm::vec3& occluderCenter, float occluderRadius,
+                          const glm::vec3& center, float radius) {
+    const glm::vec3 toOccluder = occluderCenter - eye;
+    const glm::vec3 toSphere = center - eye;
+    const float occluderDist2 = glm::dot(toOccluder, toOccluder);
+    const float sphereDist = glm::length(toSphere);
+    // Eye inside either sphere: nothing to reason about
+    if (occluderDist2 <= occluderRadius * occluderRadius || sphereDist <= radius) return false;
+
+    // Every ray through the silhouette cone enters the occluder no later than the tangent distance,
+    // so a sphere entirely beyond it and inside the cone is hidden
+    const float tangentDist = std::sqrt(occluderDist2 - occluderRadius * occluderRadius);
+    if (sphereDist - radius < tangentDist) return false;
+
+    const float occluderDist = std::sqrt(occluderDist2);
+    const float coneHalfAngle = std::asin(occluderRadius / occluderDist);
+    const float sphereHalfAngle = std::asin(radius / sphereDist);
+    const float cosBetween = glm::dot(toOccluder, toSphere) / (occluderDist * sphereDist);
+    const float between = std::acos(std::max(-1.0f, std::min(1.0f, cosBetween)));
+    return between + sphereHalfAngle <= coneHalfAngle;
+}
+
+OcclusionQueries::OcclusionQueries(const std::string& vertexShaderPath, const std::string& fragmentShaderPath)
+    : shader_(vertexShaderPath.c_str(), fragmentShaderPath.c_str()) {
+    // Unit cube, outward-facing CCW triangles so back-face culling keeps only the near faces
+    const float corners[] = {
+        -1.0f, -1.0f, -1.0f,   1.0f, -1.0f, -1.0f,   1.0f,  1.0f, -1.0f,  -1.0f,  1.0f, -1.0f,
+        -1.0f, -1.0f,  1.0f,   1.0f, -1.0f,  1.0f,   1.0f,  1.0f,  1.0f,  -1.0f,  1.0f,  1.0f,
+    };
+    const unsigned int indices[] = {
+        0, 2, 1, 0, 3, 2,   // -z
+        4, 5, 6, 4, 6, 7,   // +z
+        0, 1, 5, 0, 5, 4,   // -y
+        3, 6, 2, 3, 7, 6,   // +y
+        0, 4, 7, 0, 7, 3,   // -x
+        1, 2, 6, 1, 6, 5,   // +x
+    };
+    glGenVertexArrays(1, &boxVAO_);
+    glGenBuffers(1, &boxVBO_);
+    glGenBuffers(1, &boxEBO_);
+    glState().bindVertexArray(boxVAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, boxVBO_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, boxEBO_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glState().bindVertexArray(0);
+}
+
+OcclusionQueries::~OcclusionQueries() {
+    if (!queries_.empty()) {
+        glDeleteQueries(static_cast<GLsizei>(queries_.size()), queries_.data());
+    }
+    glState().deleteVertexArray(boxVAO_);
+    glDeleteBuffers(1, &boxVBO_);
+    glDeleteBuffers(1, &boxEBO_);
+}
+
+void OcclusionQueries::issue(const std::vector<glm::vec4>& spheres, const glm::mat4& view,
+                             const glm::mat4& projection, const glm::vec3& eye) {
+    MY_TRACE_SCOPE("OcclusionQueries::issue");
+    if (queries_.size() < spheres.size()) {
+        const size_t first = queries_.size();
+        queries_.resize(spheres.size());
+        glGenQueries(static_cast<GLsizei>(spheres.size() - first), queries_.data() + first);
+        pending_.resize(spheres.size(), 0);
+        visible_.resize(spheres.size(), 1);
+    }
+
+    // Test against the frame's depth buffer without changing it
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glState().enable(GL_DEPTH_TEST);
+    shader_.use();
+    shader_.setMat4("view", view);
+    shader_.setMat4("projection", projection);
+    glState().bindVertexArray(boxVAO_);
+
+    RenderCounters& counters = frameRenderCounters();
+    for (size_t id = 0; id < spheres.size(); ++id) {
+        if (pending_[id]) {
+            GLuint available = 0;
+            glGetQueryObjectuiv(queries_[id], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) continue;
+            GLuint anyPassed = 0;
+            glGetQueryObjectuiv(queries_[id], GL_QUERY_RESULT, &anyPassed);
+            visible_[id] = anyPassed ? 1 : 0;
+            pending_[id] = 0;
+        }
+        const glm::vec3 center(spheres[id]);
+        const float radius = spheres[id].w;
+        // The near plane would clip a box around the eye: always visible
+        if (glm::length(center - eye) <= radius * 1.7320508f) {
+            visible_[id] = 1;
+            continue;
+        }
+        glm::mat4 box = glm::scale(glm::translate(glm::mat4(1.0f), center), glm::vec3(radius));
+        shader_.setMat4("model", box);
+        glBeginQuery(GL_ANY_SAMPLES_PASSED, queries_[id]);
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, (void*)0);
+        glEndQuery(GL_ANY_SAMPLES_PASSED);
+        pending_[id] = 1;
+        ++counters.drawCalls;
+    }
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+}
@@ -0,0 +1,117 @@
+#include <my_ort.hpp>
+
+#ifdef MY_WITH_ONNXRUNTIME
+#include <onnxruntime_cxx_api.h>
+
+#include <vector>
+
+struct OrtDetector::Impl {
+    Ort::Env env{ORT_LOGGING_LEVEL_WARNING, "MillSpinningGlobe"};
+    Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    std::unique_ptr<Ort::Session> session;
+    std::unique_ptr<Ort::IoBinding> binding;
+    Ort::Value inputTensor{nullptr};
+    Ort::Value outputTensor{nullptr};
+    std::string inputName;
+    std::string outputName;
+    cv::Mat outputBuffer;
+    const void* boundInput = nullptr;
+};
+
+OrtDetector::OrtDetector() : impl_(new Impl) {}
+
+OrtDetector::~OrtDetector() = default;
+
+bool OrtDetector::available() {
+    return true;
+}
+
+bool OrtDetector::load(const std::string& onnxPath, int inputSize, int intraOpThreads, std::string& err) {
+    try {
+        Ort::SessionOptions options;
+        options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+        options.SetExecutionMode(ExecutionMode::ORT_SEQUENTIAL);
+        options.SetInterOpNumThreads(1);
+        if (intraOpThreads > 0) {
+            options.SetIntraOpNumThreads(intraOpThreads);
+        }
+        impl_->session = std::make_unique<Ort::Session>(impl_->env, onnxPath.c_str(), options);
+
+        Ort::AllocatorWithDefaultOptions allocator;
+        impl_->inputName = impl_->session->GetInputNameAllocated(0, allocator).get();
+        impl_->outputName = impl_->session->GetOutputNameAllocated(0, allocator).get();
+
+        // Preallocated NCHW input, bound once
+        const int inputDims[4] = {1, 3, inputSize, inputSize};
+        inputBlob_.create(4, inputDims, CV_32F);
+        inputBlob_.setTo(0);
+        const int64_t inputShape[4] = {1, 3, inputSize, inputSize};
+        impl_->inputTensor = Ort::Value::CreateTensor<float>(impl_->memoryInfo, inputBlob_.ptr<float>(),
+            inputBlob_.total(), inputShape, 4);
+        impl_->boundInput = inputBlob_.data;
+        impl_->binding = std::make_unique<Ort::IoBinding>(*impl_->session);
+        impl_->binding->BindInput(impl_->inputName.c_str(), impl_->inputTensor);
+
+        // One dry run lets ONNX Runtime report the (possibly symbolic) output shape
+        impl_->binding->BindOutput(impl_->outputName.c_str(), impl_->memoryInfo);
+        impl_->session->Run(Ort::RunOptions{nullptr}, *impl_->binding);
+        std::vector<Ort::Value> outputs = impl_->binding->GetOutputValues();
+        std::vector<int64_t> outputShape = outputs.front().GetTensorTypeAndShapeInfo().GetShape();
+
+        // Then bind a preallocated output buffer of that shape
+        std::vector<int> outputDims(outputShape.begin(), outputShape.end());
+        impl_->outputBuffer.create(static_cast<int>(outputDims.size()), outputDims.data(), CV_32F);
+        impl_->outputTensor = Ort::Value::CreateTensor<float>(impl_->memoryInfo, impl_->outputBuffer.ptr<float>(),
+            impl_->outputBuffer.total(), outputShape.data(), outputShape.size());
+        impl_->binding->ClearBoundOutputs();
+        impl_->binding->BindOutput(impl_->outputName.c_str(), impl_->outputTensor);
+        return true;
+    } catch (const std::exception& e) {
+        err = std::string("ONNX Runtime: ") + e.what();
+        impl_->session.reset();
+        return false;
+    }
+}
+
+bool OrtDetector::run(cv::Mat& output, std::string& err) {
+    if (!impl_->session) {
+        err = "ONNX Runtime session not loaded";
+        return false;
+    }
+    if (inputBlob_.data != impl_->boundInput) {
+        err = "ONNX Runtime input tensor was reallocated (input size changed?)";
+        return false;
+    }
+    try {
+        impl_->session->Run(Ort::RunOptions{nullptr}, *impl_->binding);
+    } catch (const std::exception& e) {
+        err = std::string("ONNX Runtime: ") + e.what();
+        return false;
+    }
+    output = impl_->outputBuffer;
+    return true;
+}
+
+#else
+
+struct OrtDetector::Impl {};
+
+OrtDetector::OrtDetector() : impl_(new Impl) {}
+
+OrtDetector::~OrtDetector() = default;
+
+bool OrtDetector::available() {
+    return false;
+}
+
+bool OrtDetector::load(const std::string&, int, int, std::string& err) {
+    err = "Built without ONNX Runtime (configure with -DMILL_WITH_ONNXRUNTIME=ON)";
+    return false;
+}
+
+bool OrtDetector::run(cv::Mat&, std::string& err) {
+    err = "Built without ONNX Runtime";
+    return false;
+}
+
+#endif
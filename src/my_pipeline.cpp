@@ -0,0 +1,114 @@
+#include <my_pipeline.hpp>
+#include <my_latency.hpp>
+#include <my_trace.hpp>
+
+#include <chrono>
+#include <iostream>
+
+FramePipeline::FramePipeline(MyWebcam& webcam, HandTracker& tracker, int fps)
+    : webcam_(webcam), tracker_(tracker), fps_(fps > 0 ? fps : 30), running_(false) {}
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+void FramePipeline::start() {
+    if (running_.exchange(true)) return;
+    captureThread_ = std::thread(&FramePipeline::captureLoop_, this);
+    inferenceThread_ = std::thread(&FramePipeline::inferenceLoop_, this);
+}
+
+void FramePipeline::stop() {
+    if (!running_.exchange(false)) return;
+    if (captureThread_.joinable()) captureThread_.join();
+    if (inferenceThread_.joinable()) inferenceThread_.join();
+}
+
+bool FramePipeline::pollFrame() {
+    return renderFrames_.update();
+}
+
+bool FramePipeline::pollDetections() {
+    return detections_.update();
+}
+
+void FramePipeline::captureLoop_() {
+    Tracer::setThreadName("capture");
+    ThreadCpuScope cpu("capture");
+    std::string err;
+    if (!pinCurrentThread(threadConfig_.captureCores, err)) {
+        std::cerr << "Warning: capture affinity: " << err << std::endl;
+    }
+    err.clear();
+    if (!raiseCurrentThreadPriority(threadConfig_.capturePriority, err) || !err.empty()) {
+        std::cerr << "Warning: capture priority: " << err << std::endl;
+    }
+
+    // Live devices pace themselves; files and synthetic frames are paced to the target fps
+    const bool selfPaced = !webcam_.isFile() && !webcam_.isSynthetic();
+    const auto framePeriod = std::chrono::nanoseconds(1000000000LL / fps_);
+    auto nextFrame = SteadyClock::now();
+
+    std::string errMsg;
+    bool reportedError = false;
+    uint64_t frameId = 0;
+    while (running_.load(std::memory_order_relaxed)) {
+        if (!selfPaced) {
+            std::this_thread::sleep_until(nextFrame);
+            nextFrame += framePeriod;
+        }
+
+        // Decode straight into the renderer's buffer, then hand the detector a copy
+        FramePacket& packet = renderFrames_.writeBuffer();
+        if (webcam_.readFrame(packet.frame, errMsg) != 0) {
+            if (webcam_.rewind()) continue;
+            if (!reportedError) {
+                std::cerr << "Warning: " << errMsg << " (continuing; will retry each frame)" << std::endl;
+                reportedError = true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        packet.frameId = frameId++;
+        packet.captureNs = webcam_.lastCaptureNs();
+
+        FramePacket& forDetector = inferenceFrames_.writeBuffer();
+        packet.frame.copyTo(forDetector.frame);
+        forDetector.frameId = packet.frameId;
+        forDetector.captureNs = packet.captureNs;
+
+        renderFrames_.publish();
+        inferenceFrames_.publish();
+    }
+}
+
+void FramePipeline::inferenceLoop_() {
+    Tracer::setThreadName("inference");
+    ThreadCpuScope cpu("inference");
+    // OpenCV's worker pool already runs on these cores: main created it while pinned to them
+    std::string err;
+    if (!pinCurrentThread(threadConfig_.inferenceCores, err)) {
+        std::cerr << "Warning: inference affinity: " << err << std::endl;
+    }
+
+    while (running_.load(std::memory_order_relaxed)) {
+        // Always work on the newest frame; frames that arrive mid-inference are skipped
+        if (!inferenceFrames_.update()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+            continue;
+        }
+        const FramePacket& packet = inferenceFrames_.readBuffer();
+
+        DetectionPacket& out = detections_.writeBuffer();
+        out.hands = tracker_.infer(packet.frame);
+        out.frameId = packet.frameId;
+        out.captureNs = packet.captureNs;
+        out.detectNs = monotonicNowNs();
+        out.frameSize = packet.frame.size();
+        const InferenceStamp stamp{out.frameId, out.captureNs, out.detectNs};
+        detections_.publish();
+        if (!inferenceStamps_.tryPush(stamp)) {
+            droppedStamps_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include <my_render_queue.hpp>
+
+#include <cstring>
+
+bool parseDrawOrder(const std::string& name, DrawOrder& order) {
+    if (name == "none") {
+        order = DRAW_ORDER_NONE;
+    } else if (name == "front_to_back") {
+        order = DRAW_ORDER_FRONT_TO_BACK;
+    } else if (name == "back_to_front") {
+        order = DRAW_ORDER_BACK_TO_FRONT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+uint32_t RenderQueue::depthBucket(float distance, DrawOrder order) {
+    if (order == DRAW_ORDER_NONE) return 0;
+    const float clamped = distance > 0.0f ? distance : 0.0f; // behind the camera counts as nearest
+    uint32_t bucket;
+    std::memcpy(&bucket, &clamped, sizeof(bucket));
+    return order == DRAW_ORDER_BACK_TO_FRONT ? ~bucket : bucket;
+}
+
+void RenderQueue::clear() {
+    keys_.clear();
+    items_.clear();
+}
+
+void RenderQueue::push(uint64_t key, uint32_t item) {
+    keys_.push_back(key);
+    items_.push_back(item);
+}
+
+void RenderQueue::sort() {
+    const size_t n = keys_.size();
+    if (n < 2) return;
+    keysScratch_.resize(n);
+    itemsScratch_.resize(n);
+
+    // Histograms of all eight bytes in one sweep
+    size_t counts[8][256] = {};
+    for (uint64_t key : keys_) {
+        for (int b = 0; b < 8; ++b) {
+            ++counts[b][(key >> (8 * b)) & 0xFF];
+        }
+    }
+
+    for (int b = 0; b < 8; ++b) {
+        const size_t* count = counts[b];
+        // Every key has the same byte here (unused pass or program bits): nothing to reorder
+        if (count[(keys_[0] >> (8 * b)) & 0xFF] == n) continue;
+
+        size_t offsets[256];
+        size_t sum = 0;
+        for (int d = 0; d < 256; ++d) {
+            offsets[d] = sum;
+            sum += count[d];
+        }
+        // Stable scatter keeps the order of the bytes already sorted
+        for (size_t i = 0; i < n; ++i) {
+            const size_t dst = offsets[(keys_[i] >> (8 * b)) & 0xFF]++;
+            keysScratch_[dst] = keys_[i];
+            itemsScratch_[dst] = items_[i];
+        }
+        keys_.swap(keysScratch_);
+        items_.swap(itemsScratch_);
+    }
+}
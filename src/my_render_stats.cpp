@@ -0,0 +1,52 @@
+#include <my_render_stats.hpp>
+
+RenderCounters& RenderCounters::operator+=(const RenderCounters& other) {
+    vaoBinds += other.vaoBinds;
+    bufferBinds += other.bufferBinds;
+    textureBinds += other.textureBinds;
+    drawCalls += other.drawCalls;
+    stateIssued += other.stateIssued;
+    stateElided += other.stateElided;
+    cullTested += other.cullTested;
+    cullRejected += other.cullRejected;
+    occlusionTested += other.occlusionTested;
+    occlusionRejected += other.occlusionRejected;
+    return *this;
+}
+
+static double perFrame(uint64_t count, uint64_t frames) {
+    return frames ? static_cast<double>(count) / frames : 0.0;
+}
+
+void RenderCounters::printPerFrame(uint64_t frames, std::ostream& os) const {
+    os << "GL calls per frame: " << perFrame(drawCalls, frames) << " draws, "
+       << perFrame(vaoBinds, frames) << " VAO binds, " << perFrame(bufferBinds, frames) << " buffer binds, "
+       << perFrame(textureBinds, frames) << " texture binds; state changes " << perFrame(stateIssued, frames)
+       << " issued, " << perFrame(stateElided, frames) << " elided; " << perFrame(cullRejected, frames)
+       << " of " << perFrame(cullTested, frames) << " mesh draws culled, " << perFrame(occlusionRejected, frames) << " of "
+       << perFrame(occlusionTested, frames) << " orbiters occluded" << std::endl;
+}
+
+void RenderCounters::writeJsonPerFrame(uint64_t frames, std::ostream& os) const {
+    os << "{\"draw_calls\": " << perFrame(drawCalls, frames)
+       << ", \"vao_binds\": " << perFrame(vaoBinds, frames)
+       << ", \"buffer_binds\": " << perFrame(bufferBinds, frames)
+       << ", \"texture_binds\": " << perFrame(textureBinds, frames)
+       << ", \"state_issued\": " << perFrame(stateIssued, frames)
+       << ", \"state_elided\": " << perFrame(stateElided, frames)
+       << ", \"cull_tested\": " << perFrame(cullTested, frames)
+       << ", \"cull_rejected\": " << perFrame(cullRejected, frames)
+       << ", \"occlusion_tested\": " << perFrame(occlusionTested, frames)
+       << ", \"occlusion_rejected\": " << perFrame(occlusionRejected, frames) << "}";
+}
+
+RenderCounters& frameRenderCounters() {
+    static RenderCounters counters;
+    return counters;
+}
+
+void endRenderFrame(RenderCounters& total) {
+    RenderCounters& frame = frameRenderCounters();
+    total += frame;
+    frame = RenderCounters();
+}
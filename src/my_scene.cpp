@@ -0,0 +1,300 @@
+#include <my_scene.hpp>
+#include <my_gl_state.hpp>
+#include <my_render_stats.hpp>
+#include <my_trace.hpp>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <iostream>
+#include <iterator>
+
+#include <glm/gtc/type_ptr.hpp>
+
+void configureGLState() {
+    glState().enable(GL_DEPTH_TEST);    // Depth-testing
+    glDepthFunc(GL_LESS);               // Smaller value as "closer" for depth-testing
+    glState().enable(GL_CULL_FACE);     // Cull back faces to reduce fragment work
+    glCullFace(GL_BACK);    
+    glFrontFace(GL_CCW);
+}
+
+// Inputs: view, proj (glm::mat4), winW, winH, palmWinPx (window pixels, origin top-left), planeDist d
+glm::vec3 screenToWorldOnPlane(glm::mat4 view, glm::mat4 proj,
+                               int winW, int winH,
+                               glm::vec2 palmWinPx, float planeDist) {
+    glm::ivec4 viewport(0, 0, winW, winH);
+
+    // glm::unProject expects origin at bottom-left: flip Y
+    glm::vec3 winNear(palmWinPx.x, float(winH) - palmWinPx.y, 0.0f);
+    glm::vec3 winFar (palmWinPx.x, float(winH) - palmWinPx.y, 1.0f);
+
+    glm::vec3 pNear = glm::unProject(winNear, view, proj, viewport);
+    glm::vec3 pFar  = glm::unProject(winFar,  view, proj, viewport);
+    glm::vec3 dir   = glm::normalize(pFar - pNear);
+
+    // Camera world pose and forward
+    glm::mat4 invV = glm::inverse(view);
+    glm::vec3 camPos = glm::vec3(invV[3]);
+    glm::vec3 camFwd = glm::normalize(glm::vec3(invV * glm::vec4(0, 0, -1, 0))); // -Z in view space
+
+    // Plane: point at camPos + d*camFwd, normal = camFwd
+    glm::vec3 planePoint = camPos + camFwd * planeDist;
+    float denom = glm::dot(dir, camFwd);
+    if (fabs(denom) < 1e-6f) return pNear; // nearly parallel; fallback
+
+    float t = glm::dot(planePoint - pNear, camFwd) / denom;
+    return pNear + t * dir;
+}
+
+GlobeScene::GlobeScene(const CLIOptions& options)
+    : options_(options),
+      earthShader_(options.earthVertexShaderPath.c_str(), options.earthFragmentShaderPath.c_str()),
+      earthModel_(options.earthModelPath, "Earth", options.keepMeshData),
+      moonModel_(options.moonModelPath, "Moon", options.keepMeshData),
+      spitfireModel_(options.spitfireModelPath, "Spitfire", options.keepMeshData),
+      batchShader_(options.batchVertexShaderPath.c_str(), options.earthFragmentShaderPath.c_str()),
+      prevPalmPos_(options.screenWidth / 2, options.screenHeight / 2) {
+    if (!parseDrawOrder(options_.drawOrder, drawOrder_)) {
+        std::cerr << "Warning: unknown draw_order '" << options_.drawOrder << "', using front_to_back" << std::endl;
+    }
+    if (options_.batchedSubmission) {
+        batch_.build({&earthModel_, &moonModel_, &spitfireModel_});
+    }
+    if (options_.occlusionQueries) {
+        occlusionQueries_ = std::make_unique<OcclusionQueries>(options_.occlusionVertexShaderPath,
+                                                               options_.occlusionFragmentShaderPath);
+    }
+}
+
+void GlobeScene::update(float deltaTime) {
+    elapsedTime_ += deltaTime;
+
+    // Rotate the model slowly about the y-axis
+    yRot_ += 20.0f * deltaTime;
+    yRot_ = fmodf(yRot_, 360.0f);
+}
+
+void GlobeScene::followHands(const std::vector<HandResult>& hands,
+                             const glm::mat4& view, const glm::mat4& projection,
+                             int winW, int winH, int frameW, int frameH) {
+    if (hands.empty()) return;
+
+    // Only do one hand for now: highest confidence score
+    HandResult bestHand = hands[0];
+    for (const auto& hr : hands) {
+        if (hr.score > bestHand.score) {
+            bestHand = hr;
+        }
+    }
+
+    // Check if plausible match (nearby to previous palm, starting in centre of frame)
+    glm::ivec2 handPalmPos(bestHand.roi.x + bestHand.roi.width / 2, bestHand.roi.y + bestHand.roi.height / 2);
+    float distToPrevPalm = glm::length(glm::vec2(handPalmPos - prevPalmPos_));
+    if (distToPrevPalm < 100.0f) {
+        // Use bounding box center of best hand as palm point
+        if (handPalmPos.x >= 0 && handPalmPos.y >= 0 && handPalmPos.x < frameW && handPalmPos.y < frameH) {
+            glm::vec2 palmVideoPx(handPalmPos.x, handPalmPos.y - 15); // Small nudge higher (+Y axis is down in image coords)
+            glm::vec2 palmWinPx = palmVideoPx; // assuming webcam fills window; adjust if letterboxed
+            earthPos_ = screenToWorldOnPlane(view, projection, winW, winH, palmWinPx, options_.initPosition.z);
+        }
+        prevPalmPos_ = handPalmPos;
+    }
+}
+
+void GlobeScene::draw(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos) {
+    MY_TRACE_SCOPE("GlobeScene::draw");
+    // Slightly scale down to keep fully within the frame
+    glm::mat4 model = glm::identity<glm::mat4>();
+    model = glm::scale(model, glm::vec3(options_.earthScale));
+    model = glm::rotate(model, glm::radians(yRot_), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::translate(glm::mat4(1.0f), earthPos_) * model;
+
+    // Earth transform without scale: translation to earthPos and Earth rotation
+    glm::mat4 earthTR = glm::translate(glm::mat4(1.0f), earthPos_) *
+                        glm::rotate(glm::mat4(1.0f), glm::radians(yRot_), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    // Orbit in Earth's local XZ plane (equator)
+    float theta = glm::radians(elapsedTime_ * options_.spitfireOrbitSpeedDeg);
+    glm::mat4 planeModels[5];
+    planeModels[0] = spitfireMatrix_(earthTR, theta);
+
+    // Four more Spitfires spaced 90 degrees apart
+    for (int i = 0; i < 4; ++i) {
+        float angleOffset = glm::radians(90.0f * i);
+        planeModels[i + 1] = spitfireMatrix_(earthTR, theta + angleOffset);
+    }
+
+    // Apply per-mesh transform to spin propeller meshes
+    float propAngle = (2.0f * M_PI) * options_.propellerRps * elapsedTime_; // radians
+    auto propellerTransform = [&](const std::string& meshName) -> glm::mat4 {
+        std::string lower = meshName;
+        for (char& c : lower) c = static_cast<char>(::tolower(c));
+        if (lower.find("prop") != std::string::npos) {
+            return glm::rotate(glm::mat4(1.0f), propAngle, options_.propellerAxis);
+        }
+        return glm::mat4(1.0f);
+    };
+
+    // Moon orbit parameters
+    float moonTheta = glm::radians(elapsedTime_ * options_.moonOrbitSpeedDeg);
+    glm::vec3 moonOrbitPos = glm::vec3(
+        options_.moonOrbitRadius * cosf(moonTheta),
+        0.0f,
+        options_.moonOrbitRadius * sinf(moonTheta)
+    );
+
+    // Compute moon orientation to always face Earth
+    glm::vec3 moonForward = glm::normalize(-moonOrbitPos); // Point towards Earth
+    glm::vec3 moonRight = glm::normalize(glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), moonForward));
+    glm::vec3 moonUp = glm::normalize(glm::cross(moonForward, moonRight));
+
+    glm::mat4 moonBasis(1.0f);
+    moonBasis[0] = glm::vec4(moonRight, 0.0f);
+    moonBasis[1] = glm::vec4(moonUp, 0.0f);
+    moonBasis[2] = glm::vec4(moonForward, 0.0f);
+
+    glm::mat4 moonModelMatrix = earthTR
+        * glm::translate(glm::mat4(1.0f), moonOrbitPos)
+        * moonBasis
+        * glm::scale(glm::mat4(1.0f), glm::vec3(options_.moonScale));
+
+    // Set shader uniforms (the background quad turns depth testing off)
+    glState().enable(GL_DEPTH_TEST);
+    Shader& shader = options_.batchedSubmission ? batchShader_ : earthShader_;
+    shader.use();
+    shader.setMat4("view", view);
+    shader.setMat4("projection", projection);
+
+    // Lighting uniforms for current shader (world space)
+    shader.setVec3("lightPos", glm::vec3(5.0f, 0.0f, 5.0f));
+    shader.setVec3("viewPos", viewPos);
+    shader.setFloat("shininess", 32.0f);
+
+    const Frustum frustum = Frustum::fromMatrix(projection * view);
+    const glm::vec3 eye = glm::vec3(glm::inverse(view)[3]);
+
+    // Orbiters in the order of planeModels, then the Moon
+    orbiterSpheres_.clear();
+    for (const glm::mat4& planeModel : planeModels) {
+        orbiterSpheres_.push_back(transformSphere(planeModel, spitfireModel_.boundsCenter(),
+                                                  spitfireModel_.boundsRadius()));
+    }
+    orbiterSpheres_.push_back(transformSphere(moonModelMatrix, moonModel_.boundsCenter(), moonModel_.boundsRadius()));
+    markHiddenOrbiters_(model, frustum, eye);
+    const size_t MOON_ORBITER = std::size(planeModels);
+
+    if (options_.batchedSubmission) {
+        batch_.clear();
+        batch_.add(BATCH_EARTH, model);
+        for (size_t i = 0; i < std::size(planeModels); ++i) {
+            if (!orbiterHidden_[i]) batch_.add(BATCH_SPITFIRE, planeModels[i], propellerTransform);
+        }
+        if (!orbiterHidden_[MOON_ORBITER]) batch_.add(BATCH_MOON, moonModelMatrix);
+        if (options_.frustumCulling) {
+            batch_.cull(frustum);
+        }
+        batch_.submit(shader, view, drawOrder_);
+        if (occlusionQueries_) occlusionQueries_->issue(orbiterSpheres_, view, projection, eye);
+        return;
+    }
+
+    // Every mesh of every object (submission order: Earth, Spitfires, Moon)
+    draws_.clear();
+    culler_.clear();
+    auto enqueue = [&](Model& object, const glm::mat4& transform, bool spinProps) {
+        const size_t objectIndex = draws_.empty() ? 0 : draws_.back().object + 1;
+        for (size_t m = 0; m < object.meshes().size(); ++m) {
+            const Mesh& mesh = object.meshes()[m];
+            glm::mat4 meshModel = spinProps ? propellerTransform(mesh.meshName_) : glm::mat4(1.0f);
+            float depth = -(view * transform * meshModel * glm::vec4(mesh.boundsCenter(), 1.0f)).z;
+            uint64_t key = RenderQueue::makeKey(RenderQueue::PASS_OPAQUE, shader.ID_, mesh.textureSetKey(),
+                                                RenderQueue::depthBucket(depth, drawOrder_));
+            draws_.push_back({&object, m, objectIndex, transform, meshModel, key});
+            culler_.push(transform * meshModel, mesh.boundsCenter(), mesh.boundsRadius());
+        }
+    };
+    enqueue(earthModel_, model, false);
+    for (size_t i = 0; i < std::size(planeModels); ++i) {
+        if (!orbiterHidden_[i]) enqueue(spitfireModel_, planeModels[i], true);
+    }
+    if (!orbiterHidden_[MOON_ORBITER]) enqueue(moonModel_, moonModelMatrix, false);
+
+    // Queue what survives culling
+    if (options_.frustumCulling) {
+        RenderCounters& counters = frameRenderCounters();
+        counters.cullTested += culler_.size();
+        counters.cullRejected += culler_.cull(frustum);
+    }
+    queue_.clear();
+    for (size_t i = 0; i < draws_.size(); ++i) {
+        if (!options_.frustumCulling || culler_.visible(i)) {
+            queue_.push(draws_[i].key, static_cast<uint32_t>(i));
+        }
+    }
+    // Always by pass, program and texture set; draw_order only decides the depth bits
+    queue_.sort();
+
+    size_t currentObject = static_cast<size_t>(-1);
+    for (size_t i = 0; i < queue_.size(); ++i) {
+        const SceneDraw& draw = draws_[queue_.item(i)];
+        if (draw.object != currentObject) {
+            shader.setMat4("model", draw.transform);
+            currentObject = draw.object;
+        }
+        draw.model->drawMesh(shader, draw.mesh, draw.meshModel);
+    }
+    if (occlusionQueries_) occlusionQueries_->issue(orbiterSpheres_, view, projection, eye);
+}
+
+void GlobeScene::markHiddenOrbiters_(const glm::mat4& earthModel, const Frustum& frustum, const glm::vec3& eye) {
+    orbiterHidden_.assign(orbiterSpheres_.size(), 0);
+    if (!options_.occlusionCulling && !occlusionQueries_) return;
+
+    // A ball inside the Earth's surface, which only hides what is behind it if the near plane doesn't cut into it
+    const glm::vec4 earth = transformInnerSphere(earthModel, earthModel_.boundsCenter(), earthModel_.innerRadius());
+    const glm::vec4& nearPlane = frustum.planes[4];
+    const bool earthOccludes = options_.occlusionCulling
+        && glm::dot(glm::vec3(nearPlane), glm::vec3(earth)) + nearPlane.w >= earth.w;
+
+    RenderCounters& counters = frameRenderCounters();
+    for (size_t i = 0; i < orbiterSpheres_.size(); ++i) {
+        const glm::vec4& sphere = orbiterSpheres_[i];
+        bool hidden = earthOccludes
+            && sphereHiddenBySphere(eye, glm::vec3(earth), earth.w, glm::vec3(sphere), sphere.w);
+        if (!hidden && occlusionQueries_) {
+            hidden = !occlusionQueries_->visible(i);
+        }
+        orbiterHidden_[i] = hidden ? 1 : 0;
+        ++counters.occlusionTested;
+        if (hidden) ++counters.occlusionRejected;
+    }
+}
+
+glm::mat4 GlobeScene::spitfireMatrix_(const glm::mat4& earthTR, float theta) const {
+    glm::vec3 orbitPos = glm::vec3(
+        options_.spitfireOrbitRadius * cosf(theta),
+        0.0f,
+        options_.spitfireOrbitRadius * sinf(theta)
+    );
+
+    // Tangent direction along the orbit (forward direction) in Earth-local frame
+    glm::vec3 forward = glm::normalize(glm::vec3(-sinf(theta), 0.0f, cosf(theta)));
+    glm::vec3 up(0.0f, 1.0f, 0.0f); // Earth's up
+    glm::vec3 right = glm::normalize(glm::cross(forward, up));
+
+    // Recompute up to ensure orthonormal basis
+    up = glm::normalize(glm::cross(right, forward));
+
+    // Columns are the basis vectors (Earth-local): right, up, forward
+    glm::mat4 basis(1.0f);
+    basis[0] = glm::vec4(right, 0.0f);
+    basis[1] = glm::vec4(up, 0.0f);
+    basis[2] = glm::vec4(forward, 0.0f);
+
+    // Compose spitfire relative to Earth: Earth TR -> orbit translate -> orientation -> local roll -> scale
+    return earthTR
+        * glm::translate(glm::mat4(1.0f), orbitPos)
+        * basis
+        * glm::rotate(glm::mat4(1.0f), glm::radians(-45.0f), glm::vec3(0.0f, 0.0f, 1.0f))
+        * glm::scale(glm::mat4(1.0f), glm::vec3(options_.spitfireScale));
+}
@@ -0,0 +1,543 @@
+#include <my_texture_cache.hpp>
+#include <my_backend.hpp>
+#include <my_bcn.hpp>
+#include <my_gl_state.hpp>
+#include <my_ktx.hpp>
+#include <my_trace.hpp>
+
+#include <glad/glad.h>
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+// S3TC is an extension to the core profile glad was generated for
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+static bool hasS3tc() {
+    static const bool supported = [] {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (name && std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0) return true;
+        }
+        return false;
+    }();
+    return supported;
+}
+
+// GL internal format for a KTX2 vkFormat, or 0 if this driver cannot sample it.
+// `s3tc` comes from hasS3tc(), which must run on the GL thread.
+static GLenum compressedInternalFormat(uint32_t vkFormat, bool s3tc) {
+    switch (vkFormat) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK: return s3tc ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : 0;
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: return s3tc ? GL_COMPRESSED_RGBA_S3TC_DXT1_EXT : 0;
+    case VK_FORMAT_BC3_UNORM_BLOCK: return s3tc ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : 0;
+    case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK: return GL_COMPRESSED_RGB8_ETC2;
+    case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+    default: return 0;
+    }
+}
+
+static std::string readFile(const std::string& path, bool& ok) {
+    std::ifstream in(path, std::ios::binary);
+    ok = static_cast<bool>(in);
+    return ok ? std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()) : std::string();
+}
+
+// The .ktx2 MillCompressTexture wrote next to `imagePath`, or "" if there is none or the image was
+// edited after it was written
+static std::string freshKtx2Path(const std::string& imagePath) {
+    const std::filesystem::path ktx2 = std::filesystem::path(imagePath).replace_extension(".ktx2");
+    std::error_code ec;
+    const auto ktx2Time = std::filesystem::last_write_time(ktx2, ec);
+    if (ec) return std::string();
+    const auto imageTime = std::filesystem::last_write_time(imagePath, ec);
+    if (!ec && imageTime > ktx2Time) {
+        std::cout << "Compressed texture " << ktx2.string() << " is older than " << imagePath
+            << ", using the image; re-run MillCompressTexture" << std::endl;
+        return std::string();
+    }
+    return ktx2.string();
+}
+
+// Streaming PBO ring; orphaning each one on reuse means a copy never waits on the GPU
+static const size_t PBO_RING = 3;
+
+TextureCache& TextureCache::instance() {
+    static TextureCache cache;
+    return cache;
+}
+
+// GL objects are left to the context teardown; only the decode worker needs stopping
+TextureCache::~TextureCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopWorker_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+static std::string canonicalPath(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    return ec ? path : canonical.string();
+}
+
+unsigned int TextureCache::acquire(const std::string& path, TexturePlaceholder placeholder) {
+    MY_TRACE_SCOPE("TextureCache::acquire");
+    const std::string canonical = canonicalPath(path);
+    auto byPath = byPath_.find(canonical);
+    if (byPath != byPath_.end()) {
+        ++pathHits_;
+        ++entries_[byPath->second].refs;
+        return byPath->second;
+    }
+    if (streaming_) {
+        return acquireStreamed_(path, canonical, placeholder);
+    }
+
+    // Offline-compressed version next to the image, if there is one
+    bool ok = false;
+    bool compressed = false;
+    std::string encoded;
+    const std::string ktx2Path = preferCompressed_ ? freshKtx2Path(canonical) : std::string();
+    if (!ktx2Path.empty()) {
+        encoded = readFile(ktx2Path, ok);
+        compressed = ok;
+    }
+    if (!compressed) {
+        encoded = readFile(canonical, ok);
+    }
+    if (!ok) {
+        std::cout << "Texture failed to load at path: " << path << std::endl;
+        return 0;
+    }
+
+    // Same bytes under another name (copies, symlinks, other models' folders)
+    std::string hash = hashString(encoded);
+    auto byHash = byHash_.find(hash);
+    if (byHash != byHash_.end()) {
+        ++contentHits_;
+        byPath_[canonical] = byHash->second;
+        ++entries_[byHash->second].refs;
+        return byHash->second;
+    }
+
+    ++misses_;
+    size_t bytes = 0;
+    unsigned int textureId = compressed ? uploadKtx2_(encoded, path, bytes) : 0;
+    if (textureId == 0 && compressed) {
+        // Unsupported format or bad file: decode the original image as before
+        compressed = false;
+        encoded = readFile(canonical, ok);
+        if (!ok) {
+            std::cout << "Texture failed to load at path: " << path << std::endl;
+            return 0;
+        }
+        hash = hashString(encoded);
+    }
+    if (!compressed) {
+        textureId = upload_(encoded, path, bytes);
+    }
+    if (textureId == 0) return 0;
+
+    Entry& entry = entries_[textureId];
+    entry.hash = hash;
+    entry.canonicalPath = canonical;
+    entry.bytes = bytes;
+    entry.compressed = compressed;
+    compressedCount_ += compressed ? 1 : 0;
+    entry.refs = 1;
+    byPath_[canonical] = textureId;
+    byHash_[hash] = textureId;
+    totalBytes_ += bytes;
+    return textureId;
+}
+
+void TextureCache::release(unsigned int textureId) {
+    auto it = entries_.find(textureId);
+    if (it == entries_.end() || --it->second.refs > 0) return;
+
+    // Drop every path alias of this texture along with it
+    for (auto alias = byPath_.begin(); alias != byPath_.end();) {
+        alias = alias->second == textureId ? byPath_.erase(alias) : std::next(alias);
+    }
+    if (!it->second.hash.empty()) {
+        byHash_.erase(it->second.hash);
+    }
+    totalBytes_ -= it->second.bytes;
+    compressedCount_ -= it->second.compressed ? 1 : 0;
+    // Still streaming: its decoded data is dropped when it reaches pumpUploads(). It was never
+    // uploaded, so it leaves the batch without counting towards residency.
+    const bool pending = it->second.streamJob != 0;
+    entries_.erase(it);
+    glState().deleteTexture(textureId);
+    if (pending) {
+        --pendingTextures_;
+    }
+}
+
+unsigned int TextureCache::acquireStreamed_(const std::string& path, const std::string& canonical,
+                                            TexturePlaceholder placeholder) {
+    std::error_code ec;
+    if (!std::filesystem::exists(canonical, ec)) {
+        std::cout << "Texture failed to load at path: " << path << std::endl;
+        return 0;
+    }
+
+    // 1x1 stand-in, replaced level by level as pumpUploads() delivers the real mips
+    static const uint8_t grey[4] = {128, 128, 128, 255};
+    static const uint8_t flatNormal[4] = {128, 128, 255, 255};
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glState().bindTexture(0, GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 placeholder == PLACEHOLDER_FLAT_NORMAL ? flatNormal : grey);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // First texture of a new batch: the residency time is measured from here
+    if (pendingTextures_ == 0) {
+        streamStart_ = SteadyClock::now();
+    }
+    ++misses_;
+    ++pendingTextures_;
+    Entry& entry = entries_[textureID];
+    entry.canonicalPath = canonical;
+    entry.bytes = sizeof(grey);
+    entry.refs = 1;
+    entry.streamJob = nextJob_++;
+    byPath_[canonical] = textureID;
+    totalBytes_ += entry.bytes;
+
+    DecodeJob job;
+    job.job = entry.streamJob;
+    job.textureId = textureID;
+    job.path = path;
+    job.canonicalPath = canonical;
+    job.tryKtx2 = preferCompressed_;
+    job.s3tc = preferCompressed_ && hasS3tc();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    if (!worker_.joinable()) {
+        worker_ = std::thread(&TextureCache::workerLoop_, this);
+    }
+    wake_.notify_one();
+    return textureID;
+}
+
+void TextureCache::workerLoop_() {
+    Tracer::setThreadName("texture decode");
+    for (;;) {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopWorker_ || !jobs_.empty(); });
+            if (stopWorker_) return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        DecodedTexture decoded;
+        decode_(job, decoded);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            decoded_.push_back(std::move(decoded));
+        }
+        decodedReady_.notify_all();
+    }
+}
+
+void TextureCache::decode_(const DecodeJob& job, DecodedTexture& out) {
+    MY_TRACE_SCOPE("TextureCache::decode");
+    out.job = job.job;
+    out.textureId = job.textureId;
+    out.path = job.path;
+
+    // Same preference as the blocking path: a usable .ktx2 sibling first
+    bool ok = false;
+    std::string encoded;
+    const std::string ktx2Path = job.tryKtx2 ? freshKtx2Path(job.canonicalPath) : std::string();
+    if (!ktx2Path.empty()) {
+        encoded = readFile(ktx2Path, ok);
+        KtxTexture texture;
+        std::string err;
+        if (ok && readKtx2(encoded, texture, err)
+            && (out.internalFormat = compressedInternalFormat(texture.vkFormat, job.s3tc)) != 0) {
+            out.hash = hashString(encoded);
+            out.compressed = true;
+            out.width = texture.width;
+            out.height = texture.height;
+            out.bytes = texture.byteSize();
+            out.levels = std::move(texture.levels);
+            out.ok = true;
+            return;
+        }
+    }
+
+    encoded = readFile(job.canonicalPath, ok);
+    if (!ok) return;
+    out.hash = hashString(encoded);
+    int width, height, numChannels;
+    unsigned char* data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(encoded.data()),
+                                                static_cast<int>(encoded.size()), &width, &height, &numChannels, 4);
+    if (!data) return;
+
+    // RGBA8 throughout, so the mip chain can be built here rather than by glGenerateMipmap
+    out.internalFormat = GL_RGBA8;
+    out.width = width;
+    out.height = height;
+    out.levels.emplace_back(data, data + static_cast<size_t>(width) * height * 4);
+    stbi_image_free(data);
+    while (width > 1 || height > 1) {
+        std::vector<uint8_t> next;
+        downsampleRgba(out.levels.back().data(), width, height, next, width, height);
+        out.levels.push_back(std::move(next));
+    }
+    for (const auto& level : out.levels) out.bytes += level.size();
+    out.ok = true;
+}
+
+void TextureCache::pumpUploads(size_t budget) {
+    if (pendingTextures_ == 0) return;
+    MY_TRACE_SCOPE("TextureCache::pumpUploads");
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!decoded_.empty()) {
+            uploads_.push_back(std::move(decoded_.front()));
+            decoded_.pop_front();
+            uploads_.back().nextLevel = static_cast<int>(uploads_.back().levels.size()) - 1;
+        }
+    }
+
+    size_t spent = 0;
+    while (!uploads_.empty() && (budget == 0 || spent < budget)) {
+        DecodedTexture& upload = uploads_.front();
+        // Released (and maybe its name reused) while decoding
+        auto entry = entries_.find(upload.textureId);
+        if (entry == entries_.end() || entry->second.streamJob != upload.job) {
+            uploads_.pop_front();
+            continue;
+        }
+        if (upload.ok && upload.nextLevel >= 0) {
+            spent += uploadStep_(upload, budget == 0 ? std::numeric_limits<size_t>::max() : budget - spent);
+        }
+        if (!upload.ok || upload.nextLevel < 0) {
+            finishTexture_(upload);
+            uploads_.pop_front();
+        }
+    }
+}
+
+void TextureCache::finishUploads() {
+    MY_TRACE_SCOPE("TextureCache::finishUploads");
+    while (pendingTextures_ > 0) {
+        pumpUploads(0);
+        if (pendingTextures_ == 0) break;
+        std::unique_lock<std::mutex> lock(mutex_);
+        decodedReady_.wait_for(lock, std::chrono::milliseconds(10), [this] { return !decoded_.empty(); });
+    }
+}
+
+size_t TextureCache::uploadStep_(DecodedTexture& upload, size_t budget) {
+    const int level = upload.nextLevel;
+    const std::vector<uint8_t>& data = upload.levels[level];
+    const int width = std::max(1, upload.width >> level);
+    const int height = std::max(1, upload.height >> level);
+
+    // Whole rows per copy; compressed levels move in 4-row block strips
+    const int rowUnit = upload.compressed ? 4 : 1;
+    const int units = (height + rowUnit - 1) / rowUnit;
+    const size_t unitBytes = data.size() / units;
+    const int firstUnit = upload.nextRow / rowUnit;
+    const int count = static_cast<int>(std::min<size_t>(units - firstUnit, std::max<size_t>(1, budget / unitBytes)));
+    const int y = firstUnit * rowUnit;
+    const int rows = std::min(height - y, count * rowUnit);
+    const size_t bytes = count * unitBytes;
+    const uint8_t* src = data.data() + firstUnit * unitBytes;
+
+    glState().bindTexture(0, GL_TEXTURE_2D, upload.textureId);
+    if (upload.nextRow == 0) {
+        // Allocate the level; its rows may take several frames to arrive
+        if (upload.compressed) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, upload.internalFormat, width, height, 0,
+                                   static_cast<GLsizei>(data.size()), nullptr);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+
+    if (pbos_.empty()) {
+        pbos_.resize(PBO_RING);
+        glGenBuffers(static_cast<GLsizei>(PBO_RING), pbos_.data());
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbos_[nextPbo_]);
+    nextPbo_ = (nextPbo_ + 1) % PBO_RING;
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    const void* pixels = nullptr; // offset into the bound PBO
+    if (mapped) {
+        std::memcpy(mapped, src, bytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    } else {
+        // Mapping failed: copy straight from client memory instead
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        pixels = src;
+    }
+    if (upload.compressed) {
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, rows, upload.internalFormat,
+                                  static_cast<GLsizei>(bytes), pixels);
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, rows, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    upload.nextRow = y + rows;
+    if (upload.nextRow >= height) {
+        // Level complete: sample from it down to the smallest
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(upload.levels.size()) - 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+        std::vector<uint8_t>().swap(upload.levels[level]);
+        --upload.nextLevel;
+        upload.nextRow = 0;
+    }
+    return bytes;
+}
+
+void TextureCache::finishTexture_(DecodedTexture& upload) {
+    Entry& entry = entries_[upload.textureId];
+    entry.streamJob = 0;
+    if (!upload.ok) {
+        std::cout << "Texture failed to load at path: " << upload.path << " (keeping placeholder)" << std::endl;
+    } else {
+        totalBytes_ += upload.bytes - entry.bytes;
+        entry.bytes = upload.bytes;
+        entry.compressed = upload.compressed;
+        compressedCount_ += upload.compressed ? 1 : 0;
+        // Later blocking loads of the same bytes under another name can share it
+        if (byHash_.emplace(upload.hash, upload.textureId).second) {
+            entry.hash = upload.hash;
+        }
+    }
+    textureDone_();
+}
+
+void TextureCache::textureDone_() {
+    if (--pendingTextures_ > 0) return;
+    residentMs_ = elapsedMs(streamStart_, SteadyClock::now());
+    if (onResident_) {
+        onResident_(residentMs_);
+    }
+}
+
+unsigned int TextureCache::upload_(const std::string& encoded, const std::string& path, size_t& bytes) {
+    stbi_set_flip_vertically_on_load(false);
+    int width, height, numChannels;
+    unsigned char* data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(encoded.data()),
+                                                static_cast<int>(encoded.size()), &width, &height, &numChannels, 0);
+    if (!data) {
+        std::cout << "Texture failed to load at path: " << path << std::endl;
+        return 0;
+    }
+    GLenum format = GL_RGB;
+    if (numChannels == 1) {
+        format = GL_RED;
+    } else if (numChannels == 3) {
+        format = GL_RGB;
+    } else if (numChannels == 4) {
+        format = GL_RGBA;
+    }
+
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glState().bindTexture(0, GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // RGB and RED rows are not 4-byte aligned
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    // Use MIPMAPs for better texture rendering
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    stbi_image_free(data);
+
+    // Drivers pad RGB to 4 bytes per texel; a full mip chain adds a third
+    const size_t texelBytes = numChannels == 3 ? 4 : static_cast<size_t>(numChannels);
+    bytes = static_cast<size_t>(width) * height * texelBytes * 4 / 3;
+    return textureID;
+}
+
+unsigned int TextureCache::uploadKtx2_(const std::string& encoded, const std::string& path, size_t& bytes) {
+    KtxTexture texture;
+    std::string err;
+    if (!readKtx2(encoded, texture, err)) {
+        std::cout << "Compressed texture for " << path << " rejected: " << err << std::endl;
+        return 0;
+    }
+    const GLenum internalFormat = compressedInternalFormat(texture.vkFormat, hasS3tc());
+    if (internalFormat == 0) {
+        std::cout << "Compressed texture for " << path << " skipped: format " << texture.vkFormat
+            << " not supported by this driver" << std::endl;
+        return 0;
+    }
+
+    while (glGetError() != GL_NO_ERROR) {} // only report errors from this upload
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glState().bindTexture(0, GL_TEXTURE_2D, textureID);
+    int width = texture.width, height = texture.height;
+    for (size_t level = 0; level < texture.levels.size(); ++level) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), internalFormat, width, height, 0,
+                               static_cast<GLsizei>(texture.levels[level].size()), texture.levels[level].data());
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    // A partial chain must not leave the texture incomplete
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(texture.levels.size()) - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    texture.levels.size() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    if (glGetError() != GL_NO_ERROR) {
+        glState().deleteTexture(textureID);
+        std::cout << "Compressed texture for " << path << " failed to upload" << std::endl;
+        return 0;
+    }
+    bytes = texture.byteSize();
+    return textureID;
+}
+
+void TextureCache::printStats(std::ostream& os) const {
+    os << "Texture cache: " << entries_.size() << " texture(s) (" << compressedCount_ << " compressed), "
+       << totalBytes_ / (1024.0 * 1024.0) << " MiB; " << pathHits_ << " path hit(s), " << contentHits_ << " content hit(s), "
+       << misses_ << " miss(es)";
+    if (pendingTextures_ > 0) {
+        os << "; " << pendingTextures_ << " streaming";
+    }
+    os << std::endl;
+}
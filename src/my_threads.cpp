@@ -0,0 +1,137 @@
+#include <my_threads.hpp>
+#include <my_latency.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+bool parseCoreList(const std::string& spec, std::vector<int>& cores, std::string& err) {
+    cores.clear();
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        try {
+            size_t dash = item.find('-');
+            int first = std::stoi(item.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            if (first < 0 || last < first) throw std::invalid_argument(item);
+            for (int c = first; c <= last; ++c) cores.push_back(c);
+        } catch (...) {
+            err = "Invalid core list entry '" + item + "' in '" + spec + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool pinCurrentThread(const std::vector<int>& cores, std::string& err) {
+    if (cores.empty()) return true;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : cores) {
+        if (c >= CPU_SETSIZE) {
+            err = "Core " + std::to_string(c) + " out of range";
+            return false;
+        }
+        CPU_SET(c, &set);
+    }
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        err = std::string("pthread_setaffinity_np: ") + std::strerror(rc);
+        return false;
+    }
+    return true;
+}
+
+bool currentThreadCores(std::vector<int>& cores, std::string& err) {
+    cores.clear();
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    int rc = pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        err = std::string("pthread_getaffinity_np: ") + std::strerror(rc);
+        return false;
+    }
+    for (int c = 0; c < CPU_SETSIZE; ++c) {
+        if (CPU_ISSET(c, &set)) cores.push_back(c);
+    }
+    return true;
+}
+
+bool raiseCurrentThreadPriority(int priority, std::string& err) {
+    if (priority <= 0) return true;
+    sched_param param{};
+    param.sched_priority = std::min(priority, sched_get_priority_max(SCHED_FIFO));
+    int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (rc == 0) return true;
+
+    // No CAP_SYS_NICE: the best we can do is a lower nice value for this thread
+    pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    for (int nice = -10; nice < 0; ++nice) {
+        if (setpriority(PRIO_PROCESS, tid, nice) == 0) {
+            err = "SCHED_FIFO not permitted, using nice " + std::to_string(nice);
+            return true;
+        }
+    }
+    err = std::string("Could not raise priority: ") + std::strerror(rc);
+    return false;
+}
+
+static int64_t threadCpuNowNs() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+struct ThreadCpuRecord {
+    std::string name;
+    int64_t cpuNs;
+    int64_t wallNs;
+};
+
+static std::mutex recordsMutex;
+static std::vector<ThreadCpuRecord> records;
+
+ThreadCpuScope::ThreadCpuScope(const char* name)
+    : name_(name), cpuStartNs_(threadCpuNowNs()), wallStartNs_(monotonicNowNs()), finished_(false) {}
+
+ThreadCpuScope::~ThreadCpuScope() {
+    finish();
+}
+
+void ThreadCpuScope::finish() {
+    if (finished_) return;
+    finished_ = true;
+    ThreadCpuRecord record{name_, threadCpuNowNs() - cpuStartNs_, monotonicNowNs() - wallStartNs_};
+    std::lock_guard<std::mutex> lock(recordsMutex);
+    records.push_back(record);
+}
+
+void printThreadCpuReport(std::ostream& os) {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    const double processMs = usage.ru_utime.tv_sec * 1e3 + usage.ru_utime.tv_usec / 1e3
+                           + usage.ru_stime.tv_sec * 1e3 + usage.ru_stime.tv_usec / 1e3;
+
+    std::lock_guard<std::mutex> lock(recordsMutex);
+    double namedMs = 0.0;
+    os << "Thread CPU time:" << std::endl;
+    for (const auto& r : records) {
+        double cpuMs = r.cpuNs / 1e6;
+        double wallMs = r.wallNs / 1e6;
+        namedMs += cpuMs;
+        os << "  " << r.name << ": " << cpuMs << " ms CPU over " << wallMs << " ms ("
+           << (wallMs > 0.0 ? 100.0 * cpuMs / wallMs : 0.0) << "% of a core)" << std::endl;
+    }
+    os << "  other (OpenCV/DNN workers, startup): " << std::max(0.0, processMs - namedMs) << " ms CPU" << std::endl;
+    os << "  process total: " << processMs << " ms CPU" << std::endl;
+}
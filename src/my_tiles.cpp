@@ -0,0 +1,125 @@
+#include <my_tiles.hpp>
+#include <my_motion.hpp>
+
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// Motion is measured on a 1/8 scale grey copy of the frame
+static const int THUMB_SCALE = 8;
+
+// Evenly spaced tile starts along one axis, overlapping by at least `overlap`
+static void axisStarts(int length, int tile, float overlap, std::vector<int>& starts) {
+    starts.clear();
+    if (length <= tile) {
+        starts.push_back(0);
+        return;
+    }
+    const int stride = std::max(1, static_cast<int>(std::lround(tile * (1.0f - overlap))));
+    const int count = (length - tile + stride - 1) / stride + 1;
+    for (int i = 0; i < count; ++i) {
+        starts.push_back(static_cast<int>(std::lround(static_cast<double>(i) * (length - tile) / (count - 1))));
+    }
+}
+
+void TilePlanner::configure(const TilingParams& params) {
+    params_ = params;
+    params_.overlap = std::min(std::max(params_.overlap, 0.0f), 0.9f);
+    grid_.clear();
+    gridTileSize_ = 0;
+    previous_.release();
+    sweepCursor_ = 0;
+}
+
+void TilePlanner::buildGrid_(cv::Size frameSize, int tileSize) {
+    gridFrameSize_ = frameSize;
+    gridTileSize_ = tileSize;
+    std::vector<int> xs, ys;
+    axisStarts(frameSize.width, tileSize, params_.overlap, xs);
+    axisStarts(frameSize.height, tileSize, params_.overlap, ys);
+    grid_.clear();
+    for (int y : ys) {
+        for (int x : xs) {
+            grid_.emplace_back(x, y, std::min(tileSize, frameSize.width), std::min(tileSize, frameSize.height));
+        }
+    }
+    energy_.assign(grid_.size(), 0.0f);
+    chosen_.assign(grid_.size(), 0);
+    order_.resize(grid_.size());
+    sweepCursor_ = 0;
+    previous_.release();
+}
+
+void TilePlanner::select(const cv::Mat& frameBGR, const std::vector<cv::Rect>& tracks, int tileSize,
+                         std::vector<cv::Rect>& tiles) {
+    tiles.clear();
+    if (frameBGR.empty() || tileSize <= 0) return;
+    if (frameBGR.size() != gridFrameSize_ || tileSize != gridTileSize_ || grid_.empty()) {
+        buildGrid_(frameBGR.size(), tileSize);
+    }
+    ++framesPlanned_;
+    std::fill(chosen_.begin(), chosen_.end(), 0);
+    const size_t maxTiles = params_.maxTiles;
+
+    auto take = [&](size_t t) {
+        if (chosen_[t] || tiles.size() >= maxTiles) return;
+        chosen_[t] = 1;
+        tiles.push_back(grid_[t]);
+    };
+
+    // One tile per track: the one holding most of the track plus a margin for motion
+    for (const cv::Rect& track : tracks) {
+        const int marginX = track.width / 4, marginY = track.height / 4;
+        const cv::Rect expanded(track.x - marginX, track.y - marginY,
+                                track.width + 2 * marginX, track.height + 2 * marginY);
+        const cv::Point centre(track.x + track.width / 2, track.y + track.height / 2);
+        size_t best = grid_.size();
+        int bestArea = 0;
+        double bestDistance = 0.0;
+        for (size_t t = 0; t < grid_.size(); ++t) {
+            const int area = (grid_[t] & expanded).area();
+            const cv::Point tileCentre(grid_[t].x + grid_[t].width / 2, grid_[t].y + grid_[t].height / 2);
+            const double distance = cv::norm(tileCentre - centre);
+            if (area > bestArea || (area == bestArea && area > 0 && distance < bestDistance)) {
+                best = t;
+                bestArea = area;
+                bestDistance = distance;
+            }
+        }
+        if (best < grid_.size()) take(best);
+    }
+
+    // Motion since the previous frame, per tile
+    cv::Mat small;
+    cv::resize(frameBGR, small, cv::Size(std::max(1, frameBGR.cols / THUMB_SCALE),
+                                         std::max(1, frameBGR.rows / THUMB_SCALE)), 0, 0, cv::INTER_AREA);
+    cv::cvtColor(small, thumbnail_, frameBGR.channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY);
+    if (!previous_.empty() && previous_.size() == thumbnail_.size()) {
+        const cv::Rect bounds(0, 0, thumbnail_.cols, thumbnail_.rows);
+        for (size_t t = 0; t < grid_.size(); ++t) {
+            const cv::Rect& r = grid_[t];
+            cv::Rect cell = cv::Rect(r.x / THUMB_SCALE, r.y / THUMB_SCALE,
+                                     r.width / THUMB_SCALE, r.height / THUMB_SCALE) & bounds;
+            energy_[t] = cell.area() > 0 ? meanAbsDiff(thumbnail_(cell), previous_(cell)) : 0.0f;
+        }
+        std::iota(order_.begin(), order_.end(), 0);
+        std::sort(order_.begin(), order_.end(), [&](int a, int b) { return energy_[a] > energy_[b]; });
+        for (int t : order_) {
+            if (energy_[t] <= params_.motionThreshold) break;
+            take(t);
+        }
+    }
+    std::swap(previous_, thumbnail_);
+
+    // Spare capacity: advance the sweep by one tile
+    for (size_t n = 0; n < grid_.size() && tiles.size() < maxTiles; ++n) {
+        size_t t = sweepCursor_;
+        sweepCursor_ = (sweepCursor_ + 1) % grid_.size();
+        if (!chosen_[t]) {
+            take(t);
+            break;
+        }
+    }
+    tilesSelected_ += tiles.size();
+}
@@ -0,0 +1,126 @@
+#include <my_trace.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Events kept per thread; older events are overwritten once the ring wraps
+static const uint64_t TRACE_RING_CAPACITY = 1 << 16;
+
+// One ring per thread. Only the owning thread writes events/head; the dumper
+// copies the buffered events without stopping it, then re-reads head and drops
+// any slot the writer may have reused during the copy.
+struct TraceRing {
+    int tid = 0;
+    std::string threadName;
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> head{0}; // total events ever written
+};
+
+static std::mutex registryMutex;
+static std::vector<std::shared_ptr<TraceRing>> registry;
+
+std::atomic<bool> Tracer::enabled_{false};
+
+// Calling thread's ring, registered on first use
+static TraceRing& localRing() {
+    thread_local std::shared_ptr<TraceRing> ring;
+    if (!ring) {
+        ring = std::make_shared<TraceRing>();
+        ring->events.resize(TRACE_RING_CAPACITY);
+        std::lock_guard<std::mutex> lock(registryMutex);
+        ring->tid = static_cast<int>(registry.size()) + 1;
+        registry.push_back(ring);
+    }
+    return *ring;
+}
+
+void Tracer::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const char* name) {
+    TraceRing& ring = localRing();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    ring.threadName = name;
+}
+
+void Tracer::record(const char* name, int64_t startNs, int64_t endNs) {
+    TraceRing& ring = localRing();
+    uint64_t h = ring.head.load(std::memory_order_relaxed);
+    ring.events[h & (TRACE_RING_CAPACITY - 1)] = {name, startNs, endNs - startNs};
+    ring.head.store(h + 1, std::memory_order_release);
+}
+
+bool Tracer::dump(const std::string& path, std::string& errMsg) {
+    std::ofstream out(path);
+    if (!out) {
+        errMsg = "Could not open trace file " + path;
+        return false;
+    }
+
+    // Snapshot every ring while its thread may still be recording
+    struct ThreadSnapshot {
+        int tid;
+        std::string name;
+        std::vector<TraceEvent> events;
+    };
+    std::vector<ThreadSnapshot> snapshots;
+    int64_t baseNs = std::numeric_limits<int64_t>::max();
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& ring : registry) {
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            uint64_t count = std::min(head, TRACE_RING_CAPACITY);
+            ThreadSnapshot snap{ring->tid, ring->threadName, {}};
+            snap.events.reserve(count);
+            for (uint64_t i = head - count; i < head; ++i) {
+                snap.events.push_back(ring->events[i & (TRACE_RING_CAPACITY - 1)]);
+            }
+            // Keep the copies above before the head re-read. The writer may be filling index
+            // newHead, which shares a slot with newHead - capacity, so that index and older
+            // ones could be torn.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t newHead = ring->head.load(std::memory_order_relaxed);
+            uint64_t firstValid = newHead >= TRACE_RING_CAPACITY ? newHead - TRACE_RING_CAPACITY + 1 : 0;
+            if (firstValid > head - count) {
+                uint64_t overwritten = std::min(firstValid - (head - count), count);
+                snap.events.erase(snap.events.begin(), snap.events.begin() + overwritten);
+            }
+            for (const TraceEvent& e : snap.events) {
+                baseNs = std::min(baseNs, e.startNs);
+            }
+            snapshots.push_back(std::move(snap));
+        }
+    }
+
+    // Chrome trace_event format, timestamps in microseconds from the first event
+    size_t total = 0;
+    bool first = true;
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    out << std::fixed << std::setprecision(3);
+    for (const auto& snap : snapshots) {
+        if (!snap.name.empty()) {
+            out << (first ? "" : ",\n")
+                << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << snap.tid
+                << ", \"args\": {\"name\": \"" << snap.name << "\"}}";
+            first = false;
+        }
+        for (const auto& e : snap.events) {
+            out << (first ? "" : ",\n")
+                << "{\"name\": \"" << e.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << snap.tid
+                << ", \"ts\": " << (e.startNs - baseNs) / 1000.0
+                << ", \"dur\": " << e.durNs / 1000.0 << "}";
+            first = false;
+        }
+        total += snap.events.size();
+    }
+    out << "\n]}\n";
+
+    std::cout << "Wrote " << total << " trace events to " << path << std::endl;
+    return true;
+}
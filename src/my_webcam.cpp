@@ -1,7 +1,28 @@
 #include <my_webcam.hpp>
+#include <my_trace.hpp>
+#include <my_latency.hpp>
 
 MyWebcam::MyWebcam(const std::string camName, const std::string deviceName, int frameWidth, int frameHeight, int FPS)
-    : camName_(camName), deviceName_(deviceName), frameWidth_(frameWidth), frameHeight_(frameHeight), FPS_(FPS) {
+    : camName_(camName), deviceName_(deviceName), frameWidth_(frameWidth), frameHeight_(frameHeight), FPS_(FPS),
+      isFile_(deviceName.rfind("/dev/", 0) != 0 && deviceName != "synthetic"),
+      isSynthetic_(deviceName == "synthetic"), frameCounter_(0), lastCaptureNs_(0) {
+    // Generated frames need no capture device
+    if (isSynthetic_) {
+        std::cout << "Using synthetic timestamped frames for camera " << camName_ << std::endl;
+        return;
+    }
+
+    // Recorded clips go through whichever backend can decode them
+    if (isFile_) {
+        cap_.open(deviceName_, cv::CAP_ANY);
+        if (!cap_.isOpened()) {
+            throw std::runtime_error("Error: Could not open video file " + deviceName_);
+        }
+        std::cout << "Successfully opened video file " << deviceName_
+            << " for camera " << camName_ << std::endl;
+        return;
+    }
+
     // Open camera with V4L2 backend
     cap_.open(deviceName_, cv::CAP_V4L2);
     if (!cap_.isOpened()) {
@@ -23,20 +44,69 @@ MyWebcam::~MyWebcam() {
 }
 
 int MyWebcam::readFrame(cv::Mat& frame, std::string& errMsg) {
+    MY_TRACE_SCOPE("MyWebcam::readFrame");
+    if (grabFrame(errMsg) != 0) {
+        return -1;
+    }
+    return retrieveFrame(frame, errMsg);
+}
+
+int MyWebcam::grabFrame(std::string& errMsg) {
+    MY_TRACE_SCOPE("MyWebcam::grabFrame");
+    // Synthetic frame: grey ramp with the frame id and capture time in the top strip
+    if (isSynthetic_) {
+        lastCaptureNs_ = monotonicNowNs();
+        syntheticFrame_.create(frameHeight_, frameWidth_, CV_8UC3);
+        syntheticFrame_.setTo(cv::Scalar::all(static_cast<double>(frameCounter_ % 64) + 64.0));
+        encodeFrameStamp(syntheticFrame_, static_cast<uint16_t>(frameCounter_), lastCaptureNs_);
+        ++frameCounter_;
+        return 0;
+    }
+
     // Check if camera is opened
     if (!cap_.isOpened()) {
         errMsg = "Error: Video device " + deviceName_ + " is not opened.";
         return -1;
     }
     // Capture frame
-    if (!cap_.read(frame)) {
+    if (!cap_.grab()) {
         errMsg = "Error: Could not read frame from " + camName_;
         return -1;
     }
+    lastCaptureNs_ = monotonicNowNs();
+
+    // V4L2 reports the driver's buffer timestamp (CLOCK_MONOTONIC) as POS_MSEC;
+    // only trust it if it is plausibly recent
+    if (!isFile_) {
+        double driverMs = cap_.get(cv::CAP_PROP_POS_MSEC);
+        int64_t driverNs = static_cast<int64_t>(driverMs * 1e6);
+        if (driverNs > 0 && driverNs <= lastCaptureNs_ && lastCaptureNs_ - driverNs < 1000000000LL) {
+            lastCaptureNs_ = driverNs;
+        }
+    }
+    return 0;
+}
+
+int MyWebcam::retrieveFrame(cv::Mat& frame, std::string& errMsg) {
+    MY_TRACE_SCOPE("MyWebcam::retrieveFrame");
+    if (isSynthetic_) {
+        syntheticFrame_.copyTo(frame);
+        return 0;
+    }
+
+    // Decode the grabbed frame
+    if (!cap_.retrieve(frame)) {
+        errMsg = "Error: Could not decode frame from " + camName_;
+        return -1;
+    }
     // Check valid frame
     if (frame.empty()) {
         errMsg = "Error: Frame is empty from " + camName_;
         return -1;
     } 
     return 0;
-}
\ No newline at end of file
+}
+
+bool MyWebcam::rewind() {
+    return isFile_ && cap_.set(cv::CAP_PROP_POS_FRAMES, 0);
+}
@@ -0,0 +1,163 @@
+// Deterministic checks for the SPSC primitives in my_spsc.hpp: empty/full
+// edges, index wrap-around, FIFO order and newest-value hand-off across two
+// threads. Exits non-zero on the first failed check.
+//
+//   ./MillSpscTest    (or: ctest --test-dir build)
+
+#include <my_spsc.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+}
+
+static void testQueueEmptyAndFull() {
+    SpscQueue<int, 8> queue;
+    int value = -1;
+    check(queue.empty() && queue.size() == 0, "new queue is empty");
+    check(!queue.tryPop(value), "pop from an empty queue fails");
+    check(value == -1, "failed pop leaves the output untouched");
+
+    for (int i = 0; i < 8; ++i) {
+        check(queue.tryPush(i), "push below capacity succeeds");
+    }
+    check(queue.size() == queue.capacity(), "size reaches capacity");
+    check(!queue.tryPush(8), "push into a full queue fails");
+
+    check(queue.tryPop(value) && value == 0, "pop after full returns the oldest item");
+    check(queue.tryPush(8), "push succeeds once a slot is freed");
+    check(!queue.tryPush(9), "queue is full again");
+
+    for (int i = 1; i <= 8; ++i) {
+        check(queue.tryPop(value) && value == i, "drain in push order");
+    }
+    check(queue.empty() && !queue.tryPop(value), "queue is empty after draining");
+}
+
+static void testQueueWrapAround() {
+    // Three items in flight on a four-slot ring, so every round straddles the wrap point
+    SpscQueue<uint64_t, 4> queue;
+    uint64_t pushed = 0, popped = 0;
+    for (int round = 0; round < 1000; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            check(queue.tryPush(pushed++), "push across the wrap point");
+        }
+        check(queue.size() == 3, "size across the wrap point");
+        for (int i = 0; i < 3; ++i) {
+            uint64_t value = 0;
+            check(queue.tryPop(value) && value == popped++, "pop across the wrap point in order");
+        }
+    }
+    // Full and empty still hold with indices far past the capacity
+    for (uint64_t i = 0; i < queue.capacity(); ++i) {
+        check(queue.tryPush(i), "fill after wrapping");
+    }
+    check(!queue.tryPush(0), "full after wrapping");
+    uint64_t value = 0;
+    for (uint64_t i = 0; i < queue.capacity(); ++i) {
+        check(queue.tryPop(value) && value == i, "drain after wrapping");
+    }
+    check(!queue.tryPop(value), "empty after wrapping");
+}
+
+static void testQueueTwoThreads() {
+    // A small ring keeps both the full and the empty path busy
+    static SpscQueue<uint64_t, 16> queue;
+    const uint64_t items = 1u << 20;
+
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < items; ++i) {
+            while (!queue.tryPush(i)) std::this_thread::yield();
+        }
+    });
+
+    uint64_t received = 0, outOfOrder = 0;
+    while (received < items) {
+        uint64_t value = 0;
+        if (!queue.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value != received) ++outOfOrder;
+        ++received;
+    }
+    producer.join();
+    check(outOfOrder == 0, "two-thread FIFO order");
+    check(queue.empty(), "two-thread queue drained");
+}
+
+static void testLatestSlotSingleThread() {
+    LatestSlot<int> slot;
+    check(!slot.update(), "nothing to read before the first publish");
+
+    slot.writeBuffer() = 1;
+    slot.publish();
+    slot.writeBuffer() = 2;
+    slot.publish();
+    check(slot.update() && slot.readBuffer() == 2, "update returns the newest of several publishes");
+    check(!slot.update() && slot.readBuffer() == 2, "no new value keeps the current one");
+
+    slot.writeBuffer() = 3;
+    slot.publish();
+    check(slot.update() && slot.readBuffer() == 3, "next publish is picked up");
+}
+
+// Every word carries the same sequence number, so a torn copy shows up as a mismatch
+struct Payload {
+    std::array<uint64_t, 32> words{};
+};
+
+static void testLatestSlotTwoThreads() {
+    static LatestSlot<Payload> slot;
+    const uint64_t publishes = 200000;
+
+    std::thread producer([&] {
+        for (uint64_t seq = 1; seq <= publishes; ++seq) {
+            slot.writeBuffer().words.fill(seq);
+            slot.publish();
+        }
+    });
+
+    uint64_t last = 0, torn = 0, backwards = 0;
+    while (last < publishes) {
+        if (!slot.update()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const Payload& payload = slot.readBuffer();
+        const uint64_t seq = payload.words[0];
+        for (uint64_t word : payload.words) {
+            if (word != seq) ++torn;
+        }
+        if (seq <= last) ++backwards;
+        last = seq;
+    }
+    producer.join();
+    check(torn == 0, "no torn reads across threads");
+    check(backwards == 0, "each update is newer than the last");
+    check(last == publishes, "consumer ends on the final publish");
+}
+
+int main() {
+    testQueueEmptyAndFull();
+    testQueueWrapAround();
+    testQueueTwoThreads();
+    testLatestSlotSingleThread();
+    testLatestSlotTwoThreads();
+
+    if (failures) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "SPSC checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Produces INT8 calibration data for the hand detector: samples frames from a
+// recorded clip, runs them through HandTracker's own preprocessing (letterbox,
+// scale, BGR->RGB) and writes each NCHW float blob as a .npy file that
+// tools/quantize_detector.py feeds to ONNX Runtime's static quantizer.
+//
+//   ./MillCalibrateDetector <clip> <output_dir> [samples=200] [stride=5] [input_size=640]
+
+#include <my_webcam.hpp>
+#include <my_hands.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+
+// NumPy .npy v1.0 of a float32 blob in C order
+static bool writeNpy(const std::string& path, const cv::Mat& blob, std::string& err) {
+    std::ostringstream shape;
+    shape << "(";
+    for (int d = 0; d < blob.dims; ++d) {
+        shape << blob.size[d] << (blob.dims == 1 || d + 1 < blob.dims ? ", " : "");
+    }
+    shape << ")";
+    std::string header = "{'descr': '<f4', 'fortran_order': False, 'shape': " + shape.str() + ", }";
+    // Magic (6) + version (2) + length (2) + header must be a multiple of 64, ending in '\n'
+    size_t total = 10 + header.size() + 1;
+    header.append((64 - total % 64) % 64, ' ');
+    header.push_back('\n');
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        err = "Could not write " + path;
+        return false;
+    }
+    const char magic[8] = {'\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0};
+    out.write(magic, sizeof(magic));
+    const uint16_t headerLen = static_cast<uint16_t>(header.size());
+    const char lenBytes[2] = {static_cast<char>(headerLen & 0xff), static_cast<char>(headerLen >> 8)};
+    out.write(lenBytes, 2);
+    out.write(header.data(), header.size());
+
+    cv::Mat contiguous = blob.isContinuous() ? blob : blob.clone();
+    out.write(reinterpret_cast<const char*>(contiguous.ptr<float>()), contiguous.total() * sizeof(float));
+    return static_cast<bool>(out);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <clip> <output_dir> [samples=200] [stride=5] [input_size=640]" << std::endl;
+        return 1;
+    }
+    const std::string clipPath = argv[1];
+    const std::string outputDir = argv[2];
+    const int samples = argc > 3 ? std::atoi(argv[3]) : 200;
+    const int stride = argc > 4 ? std::max(1, std::atoi(argv[4])) : 5;
+    const int inputSize = argc > 5 ? std::atoi(argv[5]) : 640;
+
+    if (mkdir(outputDir.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cerr << "Could not create " << outputDir << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<MyWebcam> source;
+    try {
+        // Frames are used at the clip's native size, exactly as the app would see them
+        source = std::make_unique<MyWebcam>("calibration", clipPath, 0, 0, 0);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::string errMsg;
+    cv::Mat frame, blob;
+    int frameIndex = 0, written = 0;
+    while (written < samples && source->readFrame(frame, errMsg) == 0) {
+        if (frameIndex++ % stride != 0) continue;
+        HandTracker::makeInputBlob(frame, inputSize, blob);
+        char name[32];
+        std::snprintf(name, sizeof(name), "/calib_%04d.npy", written);
+        if (!writeNpy(outputDir + name, blob, errMsg)) {
+            std::cerr << errMsg << std::endl;
+            return 1;
+        }
+        ++written;
+    }
+    if (written == 0) {
+        std::cerr << "No frames read from " << clipPath << ": " << errMsg << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << written << " calibration blobs (" << inputSize << "x" << inputSize
+        << ") to " << outputDir << std::endl;
+    return 0;
+}
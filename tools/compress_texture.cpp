@@ -0,0 +1,89 @@
+// Offline texture compression: decodes each image, builds its full mip chain
+// (2x2 box filter) and block-compresses every level to BC1 (opaque) or BC3
+// (with alpha) in a KTX2 file next to the image, which TextureCache then
+// uploads directly instead of decoding the image at every launch.
+//
+//   ./MillCompressTexture [--format auto|bc1|bc3] <image> [<image> ...]
+
+#include <my_bcn.hpp>
+#include <my_ktx.hpp>
+#include <my_timing.hpp>
+
+#include <stb_image.h>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static bool compressFile(const std::string& input, const std::string& formatName, std::string& err) {
+    stbi_set_flip_vertically_on_load(false); // same orientation as the runtime loader
+    int width, height, channels;
+    unsigned char* data = stbi_load(input.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        err = "Could not decode " + input;
+        return false;
+    }
+    std::vector<uint8_t> level(data, data + static_cast<size_t>(width) * height * 4);
+    stbi_image_free(data);
+
+    bool hasAlpha = false;
+    for (size_t i = 3; i < level.size() && !hasAlpha; i += 4) hasAlpha = level[i] != 255;
+    const BlockFormat format = formatName == "bc3" || (formatName == "auto" && hasAlpha) ? BLOCK_BC3 : BLOCK_BC1;
+
+    KtxTexture texture;
+    texture.vkFormat = format == BLOCK_BC1 ? VK_FORMAT_BC1_RGB_UNORM_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+    texture.width = width;
+    texture.height = height;
+    int levelWidth = width, levelHeight = height;
+    std::vector<uint8_t> next;
+    while (true) {
+        texture.levels.emplace_back();
+        compressImage(level.data(), levelWidth, levelHeight, format, texture.levels.back());
+        if (levelWidth == 1 && levelHeight == 1) break;
+        downsampleRgba(level.data(), levelWidth, levelHeight, next, levelWidth, levelHeight);
+        level.swap(next);
+    }
+
+    const std::string output = std::filesystem::path(input).replace_extension(".ktx2").string();
+    if (!writeKtx2(output, texture, "MillCompressTexture", err)) {
+        return false;
+    }
+    // What the runtime path would have used: RGB padded to 4 bytes, plus a third for mips
+    const size_t uncompressed = static_cast<size_t>(width) * height * 4 * 4 / 3;
+    std::cout << input << " -> " << output << ": " << width << "x" << height << ", "
+        << texture.levels.size() << " mips, " << (format == BLOCK_BC1 ? "BC1" : "BC3") << ", "
+        << texture.byteSize() / 1024 << " KiB (was " << uncompressed / 1024 << " KiB, "
+        << static_cast<double>(uncompressed) / texture.byteSize() << "x smaller)" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string formatName = "auto";
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc) {
+            formatName = argv[++i];
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty() || (formatName != "auto" && formatName != "bc1" && formatName != "bc3")) {
+        std::cerr << "Usage: " << argv[0] << " [--format auto|bc1|bc3] <image> [<image> ...]" << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (const std::string& input : inputs) {
+        auto start = SteadyClock::now();
+        std::string err;
+        if (!compressFile(input, formatName, err)) {
+            std::cerr << err << std::endl;
+            ++failures;
+            continue;
+        }
+        std::cout << "  compressed in " << elapsedMs(start, SteadyClock::now()) << " ms" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+"""Statically quantize the hand detector to INT8 with ONNX Runtime.
+
+Uses the calibration blobs written by MillCalibrateDetector, so activation
+ranges come from frames preprocessed exactly as HandTracker does at runtime.
+
+    ./build/MillCalibrateDetector clips/kiosk.mp4 calib 200
+    python3 tools/quantize_detector.py onnx_models/yolo11s_hand.onnx calib onnx_models/yolo11s_hand_int8.onnx
+
+Requires: pip install onnx onnxruntime numpy
+"""
+import glob
+import os
+import sys
+
+import numpy as np
+import onnx
+from onnxruntime.quantization import (CalibrationDataReader, CalibrationMethod, QuantFormat,
+                                      QuantType, quantize_static)
+from onnxruntime.quantization.shape_inference import quant_pre_process
+
+
+class BlobReader(CalibrationDataReader):
+    def __init__(self, input_name, calib_dir):
+        self.input_name = input_name
+        self.files = sorted(glob.glob(os.path.join(calib_dir, "*.npy")))
+        if not self.files:
+            raise SystemExit(f"no .npy calibration blobs in {calib_dir}")
+        self.index = 0
+
+    def get_next(self):
+        if self.index >= len(self.files):
+            return None
+        blob = np.load(self.files[self.index])
+        self.index += 1
+        return {self.input_name: blob}
+
+    def rewind(self):
+        self.index = 0
+
+
+def main():
+    if len(sys.argv) != 4:
+        raise SystemExit(__doc__)
+    fp32_path, calib_dir, int8_path = sys.argv[1:]
+
+    prepared_path = int8_path + ".prep.onnx"
+    quant_pre_process(fp32_path, prepared_path)
+    model = onnx.load(prepared_path)
+    input_name = model.graph.input[0].name
+
+    # The output concatenates box coordinates (0..640) with confidences (0..1);
+    # one shared INT8 scale would flatten the confidences, so keep it float
+    outputs = {o.name for o in model.graph.output}
+    exclude = [n.name for n in model.graph.node if any(o in outputs for o in n.output)]
+
+    quantize_static(prepared_path, int8_path, BlobReader(input_name, calib_dir),
+                    quant_format=QuantFormat.QDQ, per_channel=True,
+                    activation_type=QuantType.QInt8, weight_type=QuantType.QInt8,
+                    calibrate_method=CalibrationMethod.Percentile, nodes_to_exclude=exclude)
+    os.remove(prepared_path)
+    print(f"wrote {int8_path} (float nodes: {', '.join(exclude) or 'none'})")
+
+
+if __name__ == "__main__":
+    main()